@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "formula.hpp"
+#include "formulaArena.hpp"
+#include "lineReader.hpp"
+#include "parseFormula.hpp"
+#include "proofIndex.hpp"
+#include "proofMember.hpp"
+#include "proofSystem.hpp"
+#include "substitution.hpp"
+
+using namespace std;
+
+static const double SAMPLE_SECONDS = 0.01;
+///< Shortest wall time of one sample
+
+static const unsigned MIN_SAMPLES = 5;
+///< Count of samples taken at least
+
+static const unsigned MAX_SAMPLES = 30;
+///< Count of samples taken at most
+
+static const double STABLE_SPREAD = 0.02;
+///< Relative spread of the last samples considered stable
+
+static size_t heapBytes = 0;
+///< Bytes allocated on the heap so far
+
+static size_t heapAllocations = 0;
+///< Heap allocations so far
+
+static volatile size_t sink = 0;
+///< Results kept from being optimized away
+
+void* operator new(size_t size)
+{
+    void* memory = malloc(size == 0 ? 1 : size);
+
+    if (memory == NULL)
+    {
+        throw bad_alloc();
+    }
+    heapBytes += size;
+    heapAllocations++;
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+//! Generate formula
+
+/**
+ * Generates a balanced infix formula, negating every third level.
+ * @param depth Count of binary connective levels
+ * @param width Count of distinct propositions
+ * @param next Number of the next proposition
+ * @return Infix formula
+ */
+static string generate(unsigned depth,
+                       unsigned width,
+                       unsigned& next)
+{
+    static const char CONNECTIVES[] = ".+>=";
+
+    if (depth == 0)
+    {
+        return string(1, 'A' + next++ % width);
+    }
+    string left = generate(depth - 1, width, next);
+    string right = generate(depth - 1, width, next);
+    string formula = "(" + left + CONNECTIVES[(depth + next) % 4] + right + ")";
+    return depth % 3 == 0 ? "-" + formula : formula;
+}
+
+//! Benchmark
+
+/**
+ * Runs an operation in samples of calibrated iteration counts until the
+ * last samples agree, and prints one JSON line of the median sample.
+ * @param name Benchmark name
+ * @param operation Operation returning a value to be kept
+ */
+template <typename Operation>
+static void benchmark(const string& name,
+                      Operation operation)
+{
+    unsigned iterations = 1;
+    vector<double> samples;
+    size_t bytes;
+    size_t allocations;
+
+    // Calibration, also warming up the caches and the allocators
+    while (true)
+    {
+        auto start = chrono::steady_clock::now();
+        for (unsigned iteration = 0; iteration < iterations; iteration++)
+        {
+            sink += operation();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        if (elapsed.count() >= SAMPLE_SECONDS)
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    // Sampling until the last samples are within the spread
+    bytes = heapBytes;
+    allocations = heapAllocations;
+    while (samples.size() < MAX_SAMPLES)
+    {
+        auto start = chrono::steady_clock::now();
+        for (unsigned iteration = 0; iteration < iterations; iteration++)
+        {
+            sink += operation();
+        }
+        chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+        samples.push_back(elapsed.count() / iterations);
+        if (samples.size() >= MIN_SAMPLES)
+        {
+            auto last = minmax_element(samples.end() - MIN_SAMPLES, samples.end());
+            if (*last.second - *last.first <= STABLE_SPREAD * *last.first)
+            {
+                break;
+            }
+        }
+    }
+    bytes = heapBytes - bytes;
+    allocations = heapAllocations - allocations;
+
+    size_t count = samples.size();
+    sort(samples.begin(), samples.end());
+    double nanoseconds = samples[count / 2];
+    cout << "{\"name\":\"" << name << "\",\"ns_per_op\":" << nanoseconds
+         << ",\"ops_per_s\":" << 1e9 / nanoseconds
+         << ",\"heap_bytes_per_op\":" << (double) bytes / (count * iterations)
+         << ",\"heap_allocs_per_op\":" << (double) allocations / (count * iterations)
+         << ",\"iterations\":" << iterations << ",\"samples\":" << count
+         << ",\"stable\":" << (count < MAX_SAMPLES ? "true" : "false") << "}" << endl;
+}
+
+int main()
+{
+    static const unsigned SHAPES[][2] = {{4, 2}, {8, 4}, {12, 26}};
+    static const char* LANGUAGE_NAMES[] = {"ascii", "words", "latex"};
+    HilbertSystem system;
+
+    for (const unsigned* shape : SHAPES)
+    {
+        string suffix = "/depth=" + to_string(shape[0]) + "/width=" + to_string(shape[1]);
+        FormulaArena arena;
+        FormulaArena scratch;
+        unsigned next = 0;
+        string infix = generate(shape[0], shape[1], next);
+        Formula* formula = parseInfix({infix.data(), infix.data() + infix.size(), true}, arena);
+        Formula* copy = parseInfix({infix.data(), infix.data() + infix.size(), true}, arena);
+        string prefix = formula->printPrefix(ASCII);
+        string postfix = formula->printPostfix(ASCII);
+        string buffer;
+
+        // Parsing
+        benchmark("parsePrefix" + suffix, [&]()
+        {
+            Formula* parsed = parsePrefix({prefix.data(), prefix.data() + prefix.size(), true}, scratch);
+            scratch.reset();
+            return parsed != NULL;
+        });
+        benchmark("parseInfix" + suffix, [&]()
+        {
+            Formula* parsed = parseInfix({infix.data(), infix.data() + infix.size(), true}, scratch);
+            scratch.reset();
+            return parsed != NULL;
+        });
+        benchmark("parsePostfix" + suffix, [&]()
+        {
+            Formula* parsed = parsePostfix({postfix.data(), postfix.data() + postfix.size(), true}, scratch);
+            scratch.reset();
+            return parsed != NULL;
+        });
+
+        // Printing in each language
+        for (Language language : {ASCII, WORDS, LATEX})
+        {
+            string name = string("/") + LANGUAGE_NAMES[language] + suffix;
+            benchmark("printPrefix" + name, [&]()
+            {
+                buffer.clear();
+                formula->printPrefix(language, buffer);
+                return buffer.size();
+            });
+            benchmark("printInfix" + name, [&]()
+            {
+                buffer.clear();
+                formula->printInfix(language, buffer);
+                return buffer.size();
+            });
+            benchmark("printPostfix" + name, [&]()
+            {
+                buffer.clear();
+                formula->printPostfix(language, buffer);
+                return buffer.size();
+            });
+        }
+
+        // Comparison and matching of equal distinct trees
+        benchmark("equals" + suffix, [&]()
+        {
+            return formula->equals(copy);
+        });
+        benchmark("matches" + suffix, [&]()
+        {
+            Substitution substitution;
+            return formula->matches(copy, substitution);
+        });
+
+        // Axiom recognition of a type 2 instance over subformulas
+        unsigned first = 0;
+        unsigned second = 1;
+        unsigned third = 2;
+        string a = generate(shape[0] / 2, shape[1], first);
+        string b = generate(shape[0] / 2, shape[1], second);
+        string c = generate(shape[0] / 2, shape[1], third);
+        string axiom = "((" + a + ">(" + b + ">" + c + "))>((" + a + ">" + b + ")>(" + a + ">" + c + ")))";
+        Formula* instance = parseInfix({axiom.data(), axiom.data() + axiom.size(), true}, arena);
+        benchmark("isAxiom" + suffix, [&]()
+        {
+            return system.isAxiom(instance);
+        });
+
+        // Modus ponens deduction among unrelated implications
+        vector<ProofMember*> proof;
+        ProofIndex index(proof);
+        for (unsigned member = 0; member < 64; member++)
+        {
+            unsigned start = member;
+            string implication = "(" + generate(shape[0] / 2, shape[1], start) + ">"
+                + generate(shape[0] / 2, shape[1], start) + ")";
+            proof.push_back(new ProofMember(parseInfix({implication.data(), implication.data() + implication.size(), true}, arena),
+                                            SEARCH));
+        }
+        string implies = "(" + a + ">" + infix + ")";
+        proof.push_back(new ProofMember(parseInfix({a.data(), a.data() + a.size(), true}, arena), SEARCH));
+        proof.push_back(new ProofMember(parseInfix({implies.data(), implies.data() + implies.size(), true}, arena), SEARCH));
+        benchmark("isDeducible" + suffix, [&]()
+        {
+            return system.isDeducible(formula, proof, index).size();
+        });
+        for (ProofMember* member : proof)
+        {
+            delete member;
+        }
+    }
+    return EXIT_SUCCESS;
+}
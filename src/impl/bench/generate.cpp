@@ -0,0 +1,335 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include "formula.hpp"
+#include "formulaArena.hpp"
+
+using namespace std;
+
+//! Workload kind
+
+/**
+ * Kind of the generated lines.
+ */
+enum Kind
+{
+    FORMULAS, ///< Well-formed formulas
+    AXIOMS, ///< Instances of the Hilbert axiom schemas
+    MALFORMED, ///< Lines failing to parse in various ways
+    PROOF ///< Valid Hilbert proof without premises
+};
+
+//! Printing method
+
+/**
+ * Formula printing method of a syntax.
+ */
+typedef void (Formula::*Printer)(Language, std::string&) const;
+
+static const unordered_map<string, Kind> kinds = {
+    {"formulas", FORMULAS},
+    {"axioms", AXIOMS},
+    {"malformed", MALFORMED},
+    {"proof", PROOF}
+};
+///< Workload kinds by name
+
+static const unordered_map<string, Printer> printers = {
+    {"prefix", &Formula::printPrefix},
+    {"infix", &Formula::printInfix},
+    {"postfix", &Formula::printPostfix}
+};
+///< Printing methods by syntax name
+
+static const char BINARY_CONNECTIVES[] = ".+>=";
+///< Binary connectives to choose from
+
+//! Generator
+
+/**
+ * Seeded source of random formulas.
+ */
+class Generator
+{
+private:
+    mt19937_64 random;
+    ///< Random number engine
+
+    unsigned depth;
+    ///< Maximal formula depth
+
+    unsigned width;
+    ///< Count of distinct propositions
+public:
+    /**
+     * @param seed Random number engine seed
+     * @param depth Maximal formula depth
+     * @param width Count of distinct propositions
+     */
+    Generator(unsigned long seed,
+              unsigned depth,
+              unsigned width)
+    : random(seed), depth(depth), width(width)
+    {
+    }
+
+    /**
+     * Returns a uniformly chosen number.
+     * @param bound Exclusive upper bound
+     * @return Number below given bound
+     */
+    unsigned below(unsigned bound)
+    {
+        return uniform_int_distribution<unsigned>(0, bound - 1)(random);
+    }
+
+    /**
+     * Creates a random formula whose root is a binary connective.
+     * @param arena Arena to allocate the nodes in
+     * @param levels Maximal depth, defaults to the generator depth
+     * @return Random formula
+     */
+    Formula* binary(FormulaArena& arena,
+                    unsigned levels = 0)
+    {
+        levels = levels == 0 ? depth : levels;
+        return new (arena) Binary(BINARY_CONNECTIVES[below(4)],
+                                  formula(arena, levels - 1),
+                                  formula(arena, levels - 1));
+    }
+
+    /**
+     * Creates a random formula.
+     * @param arena Arena to allocate the nodes in
+     * @param levels Maximal depth
+     * @return Random formula
+     */
+    Formula* formula(FormulaArena& arena,
+                     unsigned levels)
+    {
+        unsigned choice = below(8);
+
+        if (levels == 0 || choice < 2)
+        {
+            return new (arena) Trivial('A' + below(width));
+        } else if (choice == 2)
+        {
+            return new (arena) Unary('-', formula(arena, levels - 1));
+        } else
+        {
+            return binary(arena, levels);
+        }
+    }
+
+    /**
+     * Creates a random instance of a Hilbert axiom schema.
+     * @param arena Arena to allocate the nodes in
+     * @return Axiom instance
+     */
+    Formula* axiom(FormulaArena& arena)
+    {
+        unsigned levels = (depth + 1) / 2;
+        Formula* a = formula(arena, levels);
+        Formula* b = formula(arena, levels);
+        Formula* c;
+
+        switch (below(3))
+        {
+            case 0:
+                return new (arena) Binary('>', a, new (arena) Binary('>', b, a));
+            case 1:
+                c = formula(arena, levels);
+                return new (arena) Binary('>',
+                                          new (arena) Binary('>', a, new (arena) Binary('>', b, c)),
+                                          new (arena) Binary('>',
+                                                             new (arena) Binary('>', a, b),
+                                                             new (arena) Binary('>', a, c)));
+            default:
+                return new (arena) Binary('>',
+                                          new (arena) Binary('>', new (arena) Unary('-', a),
+                                                             new (arena) Unary('-', b)),
+                                          new (arena) Binary('>', b, a));
+        }
+    }
+};
+
+//! Malform line
+
+/**
+ * Breaks a printed formula so that parsing it throws one of the parse
+ * exceptions, the damage chosen in turn by given selector.
+ * @param line Printed formula with a binary root
+ * @param selector Number choosing the kind of the damage
+ * @param syntax Name of the syntax the formula is printed in
+ * @param position Random number choosing the damaged character
+ */
+static void malform(string& line,
+                    unsigned selector,
+                    const string& syntax,
+                    unsigned position)
+{
+    size_t found;
+
+    switch (selector % 5)
+    {
+        case 0:
+            // Illegal character
+            line[position % line.size()] = 'a' + position % 26;
+            break;
+        case 1:
+            // Redundant element
+            if (syntax == "infix")
+            {
+                line += ')';
+            } else if (syntax == "prefix")
+            {
+                line += 'A';
+            } else
+            {
+                line.insert(0, 1, '>');
+            }
+            break;
+        case 2:
+            // Incomplete formula
+            line.pop_back();
+            break;
+        case 3:
+            // Unexpected element in infix, a doubled operator elsewhere
+            found = line.find_first_of(BINARY_CONNECTIVES);
+            line.insert(found, 1, line[found]);
+            break;
+        default:
+            // Invalid annotation in proofs, an illegal character elsewhere
+            line += " ; XX 1";
+            break;
+    }
+}
+
+//! Print usage
+
+/**
+ * Prints the command line usage and exits with failure.
+ * @param name Program name
+ */
+static void usage(const char* name)
+{
+    cerr << "Usage: " << name << " [-k formulas|axioms|malformed|proof] [-n lines] [-s seed]"
+         << " [-d depth] [-w width] [-r reuse] [-o prefix|infix|postfix]" << endl;
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc,
+         char** argv)
+{
+    Kind kind = FORMULAS;
+    unsigned long lines = 1000;
+    unsigned long seed = 1;
+    unsigned depth = 6;
+    unsigned width = 4;
+    unsigned reuse = 50;
+    string syntax = "infix";
+    int option;
+
+    try
+    {
+        while ((option = getopt(argc, argv, "k:n:s:d:w:r:o:")) != -1)
+        {
+            switch (option)
+            {
+                case 'k':
+                    kind = kinds.at(optarg);
+                    break;
+                case 'n':
+                    lines = stoul(optarg);
+                    break;
+                case 's':
+                    seed = stoul(optarg);
+                    break;
+                case 'd':
+                    depth = max(stoul(optarg), 1ul);
+                    break;
+                case 'w':
+                    width = min(max(stoul(optarg), 1ul), 26ul);
+                    break;
+                case 'r':
+                    reuse = min(stoul(optarg), 100ul);
+                    break;
+                case 'o':
+                    printers.at(optarg);
+                    syntax = optarg;
+                    break;
+                default:
+                    usage(argv[0]);
+                    break;
+            }
+        }
+    } catch (logic_error& exception)
+    {
+        usage(argv[0]);
+    }
+
+    Generator generator(seed, depth, width);
+    Printer printer = printers.at(syntax);
+    FormulaArena arena;
+    vector<Formula*> proved;
+    string line;
+
+    for (unsigned long number = 0; number < lines; number++)
+    {
+        Formula* formula;
+
+        line.clear();
+        switch (kind)
+        {
+            case FORMULAS:
+                formula = generator.formula(arena, depth);
+                break;
+            case AXIOMS:
+                formula = generator.axiom(arena);
+                break;
+            case MALFORMED:
+                formula = generator.binary(arena);
+                break;
+            default:
+                // Either a fresh axiom or an earlier line X weakened to (Y>X)
+                // through the axiom (X>(Y>X)) and modus ponens
+                if (!proved.empty() && number + 1 < lines && generator.below(100) < reuse)
+                {
+                    Formula* earlier = proved[generator.below(proved.size())];
+                    Formula* weakened = new (arena) Binary('>', generator.formula(arena, (depth + 1) / 2),
+                                                           earlier);
+                    (new (arena) Binary('>', earlier, weakened)->*printer)(ASCII, line);
+                    cout << line << '\n';
+                    line.clear();
+                    number++;
+                    formula = weakened;
+                } else
+                {
+                    formula = generator.axiom(arena);
+                }
+                proved.push_back(formula);
+                break;
+        }
+        (formula->*printer)(ASCII, line);
+        // The last malformed line stays unterminated for the unexpected end
+        if (kind != MALFORMED)
+        {
+            line += '\n';
+        } else if (number + 1 < lines)
+        {
+            malform(line, number, syntax, generator.below(line.size()));
+            line += '\n';
+        }
+        cout << line;
+        if (kind != PROOF)
+        {
+            arena.reset();
+        }
+    }
+    return EXIT_SUCCESS;
+}
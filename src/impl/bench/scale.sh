@@ -0,0 +1,79 @@
+#!/bin/sh
+
+### Initialization
+
+OUT_PATH="../out/"
+PL_CMD=$OUT_PATH"pl"
+GENERATE_CMD=$OUT_PATH"generate -s 1"
+SIZES="25000 50000 100000 200000"
+RUNS=3
+SCALE_SUCCESS=1
+
+cd bench
+echo "\nScaling..."
+
+### Measurement
+
+# Prints the best wall time of the runs in milliseconds
+measure()
+{
+	BEST=""
+	for RUN in $(seq $RUNS)
+	do
+		START=$(date +%s%N)
+		$PL_CMD "$@" > "/dev/null" 2>&1
+		END=$(date +%s%N)
+		TIME=$(( (END - START) / 1000000 ))
+		if [ -z "$BEST" ] || [ $TIME -lt $BEST ]
+		then
+			BEST=$TIME
+		fi
+	done
+	echo $BEST
+}
+
+# Runs a target at the sizes and fails if the least squares slope of the
+# times over the sizes on the log-log scale is above the limit exponent
+scale()
+{
+	NAME=$1
+	KIND=$2
+	LIMIT=$3
+	shift 3
+	POINTS=""
+	for SIZE in $SIZES
+	do
+		$GENERATE_CMD -k $KIND -n $SIZE > $OUT_PATH"scale_in.txt"
+		TIME=$(measure "$@" -f $OUT_PATH"scale_in.txt")
+		echo "{\"name\":\"$NAME\",\"lines\":$SIZE,\"ms\":$TIME}"
+		POINTS="$POINTS$SIZE $TIME\n"
+	done
+	EXPONENT=$(printf "$POINTS" | awk '
+		{ x = log($1); y = log($2 + 1); n++; sx += x; sy += y; sxx += x * x; sxy += x * y }
+		END { printf "%.2f", (n * sxy - sx * sy) / (n * sxx - sx * sx) }')
+	echo "{\"name\":\"$NAME\",\"exponent\":$EXPONENT,\"limit\":$LIMIT}"
+	if awk "BEGIN { exit !($EXPONENT > $LIMIT) }"
+	then
+		echo "> $NAME: Growth exponent $EXPONENT above $LIMIT!"
+		SCALE_SUCCESS=0
+	fi
+}
+
+### Targets
+
+scale "default" formulas 1.3
+scale "default/malformed" malformed 1.3
+scale "axiom_checker" axioms 1.3 -A
+scale "proof_checker" proof 1.5 -P 0
+scale "proof_minimizer" proof 1.5 -M 0
+
+### Summary
+
+rm -f $OUT_PATH"scale_in.txt"
+if [ $SCALE_SUCCESS -eq 1 ]
+then
+	echo "...passed!"
+else
+	echo "...failed!"
+	exit 1
+fi
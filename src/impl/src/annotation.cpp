@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "annotation.hpp"
+#include "parseException.hpp"
+
+using namespace std;
+
+//! Skip blanks
+
+/**
+ * Advances past spaces and tabulators.
+ * @param next Position to advance
+ * @param end Position past the last character
+ */
+static void skipBlanks(const char*& next,
+                       const char* end)
+{
+    while (next < end && (*next == ' ' || *next == '\t'))
+    {
+        next++;
+    }
+}
+
+Annotation::Annotation(Line& line)
+{
+    const char* separator = (const char*) memchr(line.begin, ';', line.end - line.begin);
+    if (separator == NULL)
+    {
+        return;
+    }
+    const char* next = separator + 1;
+    const char* end = line.end;
+    line.end = separator;
+
+    // Justification parsing
+    skipBlanks(next, end);
+    string keyword(next, min<size_t>(end - next, 2));
+    unsigned count;
+    if (keyword == "AX")
+    {
+        justification = AXIOM;
+        count = 1;
+    } else if (keyword == "PR")
+    {
+        justification = PREMISE;
+        count = 1;
+    } else if (keyword == "MP")
+    {
+        justification = MODUS_PONENS;
+        count = 2;
+    } else
+    {
+        ParseError(INVALID_ANNOTATION).raise();
+    }
+    next += 2;
+
+    // Indexes parsing
+    while (count-- > 0)
+    {
+        const char* start = next;
+        skipBlanks(next, end);
+        if (next == start || next == end || *next < '0' || *next > '9')
+        {
+            ParseError(INVALID_ANNOTATION).raise();
+        }
+        unsigned index = 0;
+        while (next < end && *next >= '0' && *next <= '9')
+        {
+            if (index > (~0u - 9) / 10)
+            {
+                ParseError(INVALID_ANNOTATION).raise();
+            }
+            index = index * 10 + *next++ - '0';
+        }
+        indexes.push_back(index);
+    }
+    skipBlanks(next, end);
+    if (next != end)
+    {
+        ParseError(INVALID_ANNOTATION).raise();
+    }
+}
+
+Justification Annotation::getJustification() const
+{
+    return justification;
+}
+
+const list<unsigned>& Annotation::getIndexes() const
+{
+    return indexes;
+}
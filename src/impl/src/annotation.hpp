@@ -0,0 +1,55 @@
+#ifndef ANNOTATION_HPP
+#define	ANNOTATION_HPP
+
+#include <list>
+
+#include "lineReader.hpp"
+
+//! Proof line justification
+
+/**
+ * Justifications a proof line can be annotated with.
+ */
+enum Justification
+{
+    SEARCH, ///< No annotation, the justification is to be searched for
+    AXIOM, ///< Axiom of the given type
+    PREMISE, ///< Premise of the given type
+    MODUS_PONENS ///< Deduction using the given proof lines as witnesses
+};
+
+//! Proof line annotation
+
+/**
+ * Justification given to a proof line after a semicolon, e.g. "; MP 3 7".
+ */
+class Annotation
+{
+private:
+    Justification justification = SEARCH;
+    ///< Claimed justification
+
+    std::list<unsigned> indexes;
+    ///< Axiom type, premise type or witness proof lines
+public:
+    /**
+     * Splits the annotation off given line and parses it.
+     * @param line Input line, shortened to its formula part
+     * @throw InvalidAnnotationException
+     */
+    Annotation(Line& line);
+
+    /**
+     * Justification getter.
+     * @return Claimed justification
+     */
+    Justification getJustification() const;
+
+    /**
+     * Indexes getter.
+     * @return Axiom type, premise type or witness proof lines
+     */
+    const std::list<unsigned>& getIndexes() const;
+};
+
+#endif
@@ -0,0 +1,110 @@
+#include <algorithm>
+
+#include "axiomIndex.hpp"
+
+using namespace std;
+
+AxiomIndex::Node::~Node()
+{
+    for (Node* child : children)
+    {
+        delete child;
+    }
+}
+
+unsigned AxiomIndex::getSymbol(char character)
+{
+    switch (character)
+    {
+        case '-':
+            return 0;
+        case '.':
+            return 1;
+        case '+':
+            return 2;
+        case '>':
+            return 3;
+        case '=':
+            return 4;
+        default:
+            return WILDCARD;
+    }
+}
+
+void AxiomIndex::collect(const Node* node,
+                         vector<Formula*>& pending,
+                         vector<unsigned>& types)
+{
+    if (pending.empty())
+    {
+        types.insert(types.end(), node->types.begin(), node->types.end());
+        return;
+    }
+
+    Formula* formula = pending.back();
+    unsigned symbol = getSymbol(formula->getCharacter());
+    pending.pop_back();
+
+    // Wildcard consuming the whole subformula
+    if (node->children[WILDCARD] != NULL)
+    {
+        collect(node->children[WILDCARD], pending, types);
+    }
+
+    // Connective descending into the operands
+    if (symbol != WILDCARD && node->children[symbol] != NULL)
+    {
+        if (symbol == 0)
+        {
+            pending.push_back(((Unary*) formula)->getOperand());
+            collect(node->children[symbol], pending, types);
+            pending.pop_back();
+        } else
+        {
+            pending.push_back(((Binary*) formula)->getRight());
+            pending.push_back(((Binary*) formula)->getLeft());
+            collect(node->children[symbol], pending, types);
+            pending.pop_back();
+            pending.pop_back();
+        }
+    }
+    pending.push_back(formula);
+}
+
+void AxiomIndex::insert(Formula* axiom,
+                        unsigned type)
+{
+    Node* node = &root;
+    vector<Formula*> pending = {axiom};
+
+    while (!pending.empty())
+    {
+        Formula* formula = pending.back();
+        unsigned symbol = getSymbol(formula->getCharacter());
+        pending.pop_back();
+        if (node->children[symbol] == NULL)
+        {
+            node->children[symbol] = new Node();
+        }
+        node = node->children[symbol];
+        if (symbol == 0)
+        {
+            pending.push_back(((Unary*) formula)->getOperand());
+        } else if (symbol != WILDCARD)
+        {
+            pending.push_back(((Binary*) formula)->getRight());
+            pending.push_back(((Binary*) formula)->getLeft());
+        }
+    }
+    node->types.push_back(type);
+}
+
+vector<unsigned> AxiomIndex::find(Formula* formula) const
+{
+    vector<unsigned> types;
+    vector<Formula*> pending = {formula};
+
+    collect(&root, pending, types);
+    sort(types.begin(), types.end());
+    return types;
+}
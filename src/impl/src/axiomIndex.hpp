@@ -0,0 +1,75 @@
+#ifndef AXIOM_INDEX_HPP
+#define	AXIOM_INDEX_HPP
+
+#include <vector>
+
+#include "formula.hpp"
+
+//! Axiom index
+
+/**
+ * Discrimination tree of axiom schemas over their prefix notation, in which
+ * every proposition is a wildcard standing for any subformula.
+ */
+class AxiomIndex
+{
+private:
+    static const unsigned SYMBOLS = 6;
+    ///< Count of connectives plus the wildcard
+
+    static const unsigned WILDCARD = SYMBOLS - 1;
+    ///< Wildcard symbol
+
+    //! Discrimination tree node
+
+    /**
+     * Node reached by a prefix of symbols.
+     */
+    struct Node
+    {
+        Node* children[SYMBOLS] = {};
+        ///< Nodes reached by appending each symbol
+
+        std::vector<unsigned> types;
+        ///< Types of the axioms ending at this node
+
+        ~Node();
+    };
+
+    Node root;
+    ///< Node reached by the empty prefix
+
+    /**
+     * Returns the symbol of a representing character.
+     * @param character Representing character
+     * @return Connective symbol or the wildcard for propositions
+     */
+    static unsigned getSymbol(char character);
+
+    /**
+     * Collects the types of axioms whose shape can match pending subformulas.
+     * @param node Node reached so far
+     * @param pending Subformulas left to be matched, the next one on the top
+     * @param types Collected axiom types
+     */
+    static void collect(const Node* node,
+                        std::vector<Formula*>& pending,
+                        std::vector<unsigned>& types);
+public:
+    /**
+     * Inserts an axiom schema.
+     * @param axiom Axiom schema to be inserted
+     * @param type Axiom type to be reported for the schema
+     */
+    void insert(Formula* axiom,
+                unsigned type);
+
+    /**
+     * Finds the axioms whose shape can match given formula.
+     * @param formula Formula to be matched
+     * @return Candidate axiom types in ascending order
+     */
+    std::vector<unsigned> find(Formula* formula) const;
+};
+
+#endif
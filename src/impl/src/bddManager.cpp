@@ -0,0 +1,314 @@
+#include <algorithm>
+
+#include "bddManager.hpp"
+
+using namespace std;
+
+//! Build step
+
+/**
+ * Pending node of the iterative diagram building.
+ */
+struct BuildStep
+{
+    Formula* formula;
+    ///< Node to be converted
+
+    bool expanded;
+    ///< Whether the operands have been scheduled already
+};
+
+static thread_local vector<BuildStep> steps;
+///< Build steps stack reused by the managers of each thread
+
+static thread_local vector<unsigned> diagrams;
+///< Operand diagrams stack reused by the managers of each thread
+
+const unsigned BddManager::NIL;
+const unsigned BddManager::FALSE;
+const unsigned BddManager::TRUE;
+
+BddManager::BddManager()
+: nodes({{TERMINAL, FALSE, FALSE, NIL, 1}, {TERMINAL, TRUE, TRUE, NIL, 1}}),
+  buckets(1 << 12, NIL), cache(CACHE_SIZE, {NIL, NIL, NIL, NIL})
+{
+}
+
+size_t BddManager::bucket(unsigned variable,
+                          unsigned low,
+                          unsigned high) const
+{
+    size_t hash = ((size_t) low * 0x9E3779B1u + high) * 0x85EBCA77u + variable;
+
+    return (hash ^ (hash >> 17)) & (buckets.size() - 1);
+}
+
+void BddManager::grow()
+{
+    buckets.assign(buckets.size() * 2, NIL);
+    for (unsigned number = 2; number < nodes.size(); number++)
+    {
+        Node& node = nodes[number];
+        if (node.variable != TERMINAL)
+        {
+            size_t index = bucket(node.variable, node.low, node.high);
+            node.next = buckets[index];
+            buckets[index] = number;
+        }
+    }
+}
+
+unsigned BddManager::makeNode(unsigned variable,
+                              unsigned low,
+                              unsigned high)
+{
+    if (low == high)
+    {
+        return low;
+    }
+
+    // Unique table lookup
+    size_t index = bucket(variable, low, high);
+    for (unsigned number = buckets[index]; number != NIL; number = nodes[number].next)
+    {
+        const Node& node = nodes[number];
+        if (node.variable == variable && node.low == low && node.high == high)
+        {
+            return number;
+        }
+    }
+
+    // Node allocation
+    unsigned number;
+    if (freeNodes != NIL)
+    {
+        number = freeNodes;
+        freeNodes = nodes[number].next;
+        nodes[number] = {variable, low, high, buckets[index], 0};
+    } else
+    {
+        number = nodes.size();
+        nodes.push_back({variable, low, high, buckets[index], 0});
+    }
+    buckets[index] = number;
+    if (++liveNodes > buckets.size())
+    {
+        grow();
+    }
+    return number;
+}
+
+unsigned BddManager::variable(char proposition)
+{
+    return makeNode(proposition - 'A', FALSE, TRUE);
+}
+
+unsigned BddManager::ite(unsigned condition,
+                         unsigned positive,
+                         unsigned negative)
+{
+    // Terminal cases
+    if (condition == TRUE || positive == negative)
+    {
+        return positive;
+    }
+    if (condition == FALSE)
+    {
+        return negative;
+    }
+    if (positive == TRUE && negative == FALSE)
+    {
+        return condition;
+    }
+
+    // Computed cache lookup
+    size_t hash = ((size_t) condition * 0x9E3779B1u + positive) * 0x85EBCA77u + negative;
+    CacheEntry& entry = cache[(hash ^ (hash >> 15)) & (CACHE_SIZE - 1)];
+    if (entry.condition == condition && entry.positive == positive
+        && entry.negative == negative)
+    {
+        return entry.result;
+    }
+
+    // Shannon expansion on the top variable
+    unsigned variable = min(nodes[condition].variable,
+                            min(nodes[positive].variable, nodes[negative].variable));
+    unsigned cofactors[3][2];
+    unsigned operands[3] = {condition, positive, negative};
+    for (unsigned operand = 0; operand < 3; operand++)
+    {
+        const Node& node = nodes[operands[operand]];
+        if (node.variable == variable)
+        {
+            cofactors[operand][0] = node.low;
+            cofactors[operand][1] = node.high;
+        } else
+        {
+            cofactors[operand][0] = operands[operand];
+            cofactors[operand][1] = operands[operand];
+        }
+    }
+    unsigned low = ite(cofactors[0][0], cofactors[1][0], cofactors[2][0]);
+    unsigned high = ite(cofactors[0][1], cofactors[1][1], cofactors[2][1]);
+    unsigned result = makeNode(variable, low, high);
+    entry = {condition, positive, negative, result};
+    return result;
+}
+
+unsigned BddManager::build(Formula* formula)
+{
+    unsigned left;
+    unsigned right;
+    unsigned diagram;
+
+    steps.push_back({formula, false});
+    while (!steps.empty())
+    {
+        BuildStep step = steps.back();
+        char character = step.formula->getCharacter();
+
+        steps.pop_back();
+        if (character >= 'A' && character <= 'Z')
+        {
+            diagrams.push_back(variable(character));
+            continue;
+        }
+        if (!step.expanded)
+        {
+            steps.push_back({step.formula, true});
+            if (character == '-')
+            {
+                steps.push_back({((Unary*) step.formula)->getOperand(), false});
+            } else
+            {
+                steps.push_back({((Binary*) step.formula)->getRight(), false});
+                steps.push_back({((Binary*) step.formula)->getLeft(), false});
+            }
+            continue;
+        }
+        if (character == '-')
+        {
+            diagram = ite(diagrams.back(), FALSE, TRUE);
+            diagrams.pop_back();
+        } else
+        {
+            right = diagrams.back();
+            diagrams.pop_back();
+            left = diagrams.back();
+            diagrams.pop_back();
+            switch (character)
+            {
+                case '.':
+                    diagram = ite(left, right, FALSE);
+                    break;
+                case '+':
+                    diagram = ite(left, TRUE, right);
+                    break;
+                case '>':
+                    diagram = ite(left, right, TRUE);
+                    break;
+                default:
+                    diagram = ite(left, right, ite(right, FALSE, TRUE));
+                    break;
+            }
+        }
+        diagrams.push_back(diagram);
+    }
+    diagram = diagrams.back();
+    diagrams.pop_back();
+    return diagram;
+}
+
+uint64_t BddManager::count(unsigned node,
+                           vector<uint64_t>& counts) const
+{
+    if (node == FALSE || node == TRUE || counts[node] > 0)
+    {
+        return node == TRUE ? 1 : counts[node];
+    }
+    const Node& decision = nodes[node];
+    counts[node] = (count(decision.low, counts)
+                    << (nodes[decision.low].variable - decision.variable - 1))
+        + (count(decision.high, counts)
+           << (nodes[decision.high].variable - decision.variable - 1));
+    return counts[node];
+}
+
+uint64_t BddManager::countModels(unsigned diagram,
+                                 unsigned variables) const
+{
+    vector<uint64_t> counts(nodes.size(), 0);
+
+    return count(diagram, counts) << nodes[diagram].variable >> (TERMINAL - variables);
+}
+
+void BddManager::reference(unsigned diagram)
+{
+    nodes[diagram].references++;
+}
+
+void BddManager::dereference(unsigned diagram)
+{
+    nodes[diagram].references--;
+}
+
+void BddManager::collect()
+{
+    vector<bool> marks(nodes.size(), false);
+    vector<unsigned> pending;
+
+    if (liveNodes < threshold)
+    {
+        return;
+    }
+
+    // Reachable nodes marking
+    for (unsigned number = 0; number < nodes.size(); number++)
+    {
+        if (nodes[number].references > 0)
+        {
+            pending.push_back(number);
+        }
+    }
+    while (!pending.empty())
+    {
+        unsigned number = pending.back();
+        pending.pop_back();
+        if (marks[number])
+        {
+            continue;
+        }
+        marks[number] = true;
+        if (nodes[number].variable != TERMINAL)
+        {
+            pending.push_back(nodes[number].low);
+            pending.push_back(nodes[number].high);
+        }
+    }
+
+    // Unreachable nodes release
+    fill(buckets.begin(), buckets.end(), NIL);
+    freeNodes = NIL;
+    liveNodes = 2;
+    for (unsigned number = nodes.size(); number-- > 2;)
+    {
+        Node& node = nodes[number];
+        if (marks[number])
+        {
+            size_t index = bucket(node.variable, node.low, node.high);
+            node.next = buckets[index];
+            buckets[index] = number;
+            liveNodes++;
+        } else
+        {
+            node.variable = TERMINAL;
+            node.next = freeNodes;
+            freeNodes = number;
+        }
+    }
+    fill(cache.begin(), cache.end(), CacheEntry{NIL, NIL, NIL, NIL});
+    if (liveNodes > threshold / 2)
+    {
+        threshold *= 2;
+    }
+}
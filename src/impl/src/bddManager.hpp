@@ -0,0 +1,191 @@
+#ifndef BDD_MANAGER_HPP
+#define	BDD_MANAGER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "formula.hpp"
+
+//! Binary decision diagrams manager
+
+/**
+ * Reduced ordered binary decision diagrams over the propositions A-Z in the
+ * alphabetical order, sharing all nodes in one unique table. Diagrams are
+ * identified by their root node numbers, 0 and 1 being the constants.
+ */
+class BddManager
+{
+private:
+    static const unsigned NIL = ~0u;
+    ///< Missing node number
+
+    static const unsigned TERMINAL = 'Z' - 'A' + 1;
+    ///< Variable level of the constants
+
+    static const unsigned CACHE_SIZE = 1 << 18;
+    ///< Count of computed cache entries
+
+    static const unsigned INITIAL_THRESHOLD = 1 << 16;
+    ///< Initial live nodes count triggering the garbage collection
+
+    //! Diagram node
+
+    /**
+     * Decision node testing one variable.
+     */
+    struct Node
+    {
+        unsigned variable;
+        ///< Tested variable level, TERMINAL for constants and free nodes
+
+        unsigned low;
+        ///< Successor if the variable is false
+
+        unsigned high;
+        ///< Successor if the variable is true
+
+        unsigned next;
+        ///< Next node in the same unique table bucket or the free list
+
+        unsigned references;
+        ///< Count of external references
+    };
+
+    //! Computed cache entry
+
+    /**
+     * Remembered result of an if-then-else operation.
+     */
+    struct CacheEntry
+    {
+        unsigned condition;
+        ///< Condition diagram, NIL for an empty entry
+
+        unsigned positive;
+        ///< Diagram chosen when the condition holds
+
+        unsigned negative;
+        ///< Diagram chosen otherwise
+
+        unsigned result;
+        ///< Resulting diagram
+    };
+
+    std::vector<Node> nodes;
+    ///< All nodes, the constants first
+
+    std::vector<unsigned> buckets;
+    ///< Unique table bucket heads
+
+    std::vector<CacheEntry> cache;
+    ///< Lossy computed cache of if-then-else results
+
+    unsigned freeNodes = NIL;
+    ///< Head of the released nodes list
+
+    unsigned liveNodes = 2;
+    ///< Count of allocated nodes, the constants included
+
+    unsigned threshold = INITIAL_THRESHOLD;
+    ///< Live nodes count triggering the garbage collection
+
+    /**
+     * Returns the unique node with given variable and successors.
+     * @param variable Tested variable level
+     * @param low Successor if the variable is false
+     * @param high Successor if the variable is true
+     * @return Node number
+     */
+    unsigned makeNode(unsigned variable,
+                      unsigned low,
+                      unsigned high);
+
+    /**
+     * Doubles the unique table and redistributes the nodes.
+     */
+    void grow();
+
+    /**
+     * Computes the bucket of a node.
+     * @param variable Tested variable level
+     * @param low Successor if the variable is false
+     * @param high Successor if the variable is true
+     * @return Unique table bucket index
+     */
+    size_t bucket(unsigned variable,
+                  unsigned low,
+                  unsigned high) const;
+
+    /**
+     * Counts the satisfying assignments of the variables from the level of
+     * given node on.
+     * @param node Diagram root node
+     * @param counts Counts computed so far, 0 for unknown ones
+     * @return Count of satisfying assignments
+     */
+    uint64_t count(unsigned node,
+                   std::vector<uint64_t>& counts) const;
+public:
+    static const unsigned FALSE = 0;
+    ///< Constant false diagram
+
+    static const unsigned TRUE = 1;
+    ///< Constant true diagram
+
+    BddManager();
+
+    /**
+     * Returns the diagram of a single proposition.
+     * @param proposition Proposition A-Z
+     * @return Diagram of given proposition
+     */
+    unsigned variable(char proposition);
+
+    /**
+     * Computes the if-then-else combination of diagrams.
+     * @param condition Condition diagram
+     * @param positive Diagram chosen when the condition holds
+     * @param negative Diagram chosen otherwise
+     * @return Resulting diagram
+     */
+    unsigned ite(unsigned condition,
+                 unsigned positive,
+                 unsigned negative);
+
+    /**
+     * Builds the diagram of given formula.
+     * @param formula Formula to be converted
+     * @return Diagram equivalent to given formula
+     */
+    unsigned build(Formula* formula);
+
+    /**
+     * Counts the satisfying assignments of given diagram.
+     * @param diagram Diagram to count the models of
+     * @param variables Count of propositions the assignments are made of,
+     * at least the count of variables given diagram depends on
+     * @return Count of satisfying assignments
+     */
+    uint64_t countModels(unsigned diagram,
+                         unsigned variables) const;
+
+    /**
+     * Protects given diagram from the garbage collection.
+     * @param diagram Diagram to be referenced
+     */
+    void reference(unsigned diagram);
+
+    /**
+     * Withdraws a protection of given diagram.
+     * @param diagram Diagram to be dereferenced
+     */
+    void dereference(unsigned diagram);
+
+    /**
+     * Releases the nodes unreachable from the referenced diagrams once
+     * there are too many of them. Unreferenced diagrams become invalid.
+     */
+    void collect();
+};
+
+#endif
@@ -1,16 +1,31 @@
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <getopt.h>
 #include <stdexcept>
+#include <thread>
 #include <unistd.h>
 
 #include "configuration.hpp"
 #include "executionTarget.hpp"
+#include "statistics.hpp"
 #include "usageException.hpp"
 
-map<string, Parser> Configuration::inputSyntaxes = {
+using namespace std;
+
+map<string, LineParser> Configuration::inputSyntaxes = {
     {"prefix", &parsePrefix},
     {"infix", &parseInfix},
     {"postfix", &parsePostfix}
 };
 
+map<string, LineValidator> Configuration::inputValidators = {
+    {"prefix", &validatePrefix},
+    {"infix", &validateInfix},
+    {"postfix", &validatePostfix}
+};
+
 map<string, Printer> Configuration::outputSyntaxes = {
     {"prefix", &Formula::printPrefix},
     {"infix", &Formula::printInfix},
@@ -23,13 +38,92 @@ map<string, Language> Configuration::outputLanguages = {
     {"latex", LATEX}
 };
 
+//! Diagram targets
+
+/**
+ * Diagram handler target values.
+ */
+static map<string, DiagramTarget> diagramTargets = {
+    {"tautology", DECIDE},
+    {"equivalence", COMPARE},
+    {"count", COUNT}
+};
+
+//! Statistics option
+
+/**
+ * Value of the long statistics option, past the short option characters.
+ */
+static const int STATS_OPTION = 256;
+
+//! Trace option
+
+/**
+ * Value of the long trace option, past the short option characters.
+ */
+static const int TRACE_OPTION = 257;
+
+//! Search limit options
+
+/**
+ * Values of the long search limit options, past the trace option.
+ */
+static const int DEPTH_LIMIT_OPTION = 258;
+static const int SIZE_LIMIT_OPTION = 259;
+static const int LEMMA_LIMIT_OPTION = 260;
+
+//! Long options
+
+/**
+ * Long option values.
+ */
+static const struct option longOptions[] = {
+    {"stats", optional_argument, NULL, STATS_OPTION},
+    {"trace", required_argument, NULL, TRACE_OPTION},
+    {"depth-limit", required_argument, NULL, DEPTH_LIMIT_OPTION},
+    {"size-limit", required_argument, NULL, SIZE_LIMIT_OPTION},
+    {"lemma-limit", required_argument, NULL, LEMMA_LIMIT_OPTION},
+    {NULL, 0, NULL, 0}
+};
+
+//! Jobs factor
+
+/**
+ * Greatest count of worker threads per processor.
+ */
+static const unsigned JOBS_FACTOR = 16;
+
+unsigned Configuration::parseCount(char option,
+                                  const char* value,
+                                  unsigned long least,
+                                  unsigned long greatest)
+{
+    unsigned long count;
+
+    try
+    {
+        count = stoul(value);
+    } catch (invalid_argument& exception)
+    {
+        throw IllegalValueException(option, value);
+    } catch (out_of_range& exception)
+    {
+        throw IllegalValueException(option, value);
+    }
+    if (strchr(value, '-') != NULL || count < least || count > greatest)
+    {
+        throw IllegalValueException(option, value);
+    }
+    return count;
+}
+
 Configuration::Configuration(int argc,
                              char** argv)
 {
     int option;
 
     opterr = 0;
-    while ((option = getopt(argc, argv, ":Aef:i:l:M:o:P:s")) != -1)
+    while ((option = getopt_long(argc, argv, ":AB:cD:ef:i:j:l:M:o:P:sSTu:V", longOptions, NULL)) != -1)
     {
         switch (option)
         {
@@ -42,15 +136,43 @@ Configuration::Configuration(int argc,
                     throw MultipleTargetsException(option);
                 }
                 break;
+            case 'B':
+                if (target == NULL)
+                {
+                    try
+                    {
+                        target = new DiagramHandler(diagramTargets.at(optarg));
+                    } catch (out_of_range& exception)
+                    {
+                        throw IllegalValueException(option, optarg);
+                    }
+                } else
+                {
+                    throw MultipleTargetsException(option);
+                }
+                break;
+            case 'c':
+                certificate = true;
+                break;
+            case 'D':
+                if (target == NULL)
+                {
+                    target = new ProofSearcher(parseCount(option, optarg, 0, UINT_MAX));
+                } else
+                {
+                    throw MultipleTargetsException(option);
+                }
+                break;
             case 'e':
                 echo = true;
                 break;
             case 'f':
-                file.open(optarg);
-                if (file.good())
+                if (input != STDIN_FILENO)
                 {
-                    input = &file;
-                } else
+                    close(input);
+                }
+                input = open(optarg, O_RDONLY);
+                if (input < 0)
                 {
                     throw InvalidFileException(option, optarg);
                 }
@@ -59,11 +181,19 @@ Configuration::Configuration(int argc,
                 try
                 {
                     parser = inputSyntaxes.at(optarg);
+                    validator = inputValidators.at(optarg);
                 } catch (out_of_range& exception)
                 {
                     throw IllegalValueException(option, optarg);
                 }
                 break;
+            case 'j':
+                jobs = parseCount(option, optarg, 0, JOBS_FACTOR * max(thread::hardware_concurrency(), 1u));
+                if (jobs == 0)
+                {
+                    jobs = max(thread::hardware_concurrency(), 1u);
+                }
+                break;
             case 'l':
                 try
                 {
@@ -76,16 +206,7 @@ Configuration::Configuration(int argc,
             case 'M':
                 if (target == NULL)
                 {
-                    try
-                    {
-                        target = new ProofHandler(stoul(optarg), MINIMIZE);
-                    } catch (invalid_argument& exception)
-                    {
-                        throw IllegalValueException(option, optarg);
-                    } catch (out_of_range& exception)
-                    {
-                        throw IllegalValueException(option, optarg);
-                    }
+                    target = new ProofHandler(parseCount(option, optarg, 0, UINT_MAX), MINIMIZE);
                 } else
                 {
                     throw MultipleTargetsException(option);
@@ -103,16 +224,7 @@ Configuration::Configuration(int argc,
             case 'P':
                 if (target == NULL)
                 {
-                    try
-                    {
-                        target = new ProofHandler(stoul(optarg), VERIFY);
-                    } catch (invalid_argument& exception)
-                    {
-                        throw IllegalValueException(option, optarg);
-                    } catch (out_of_range& exception)
-                    {
-                        throw IllegalValueException(option, optarg);
-                    }
+                    target = new ProofHandler(parseCount(option, optarg, 0, UINT_MAX), VERIFY);
                 } else
                 {
                     throw MultipleTargetsException(option);
@@ -121,11 +233,67 @@ Configuration::Configuration(int argc,
             case 's':
                 strict = true;
                 break;
+            case 'S':
+                if (target == NULL)
+                {
+                    target = new SatisfiabilityChecker();
+                } else
+                {
+                    throw MultipleTargetsException(option);
+                }
+                break;
+            case 'T':
+                if (target == NULL)
+                {
+                    target = new TruthTableChecker();
+                } else
+                {
+                    throw MultipleTargetsException(option);
+                }
+                break;
+            case 'u':
+                if (target == NULL)
+                {
+                    target = new RequestServer(optarg);
+                } else
+                {
+                    throw MultipleTargetsException(option);
+                }
+                break;
+            case 'V':
+                if (target == NULL)
+                {
+                    target = new FormulaValidator();
+                } else
+                {
+                    throw MultipleTargetsException(option);
+                }
+                break;
+            case STATS_OPTION:
+                Statistics::enable();
+                if (optarg != NULL)
+                {
+                    statistics = optarg;
+                }
+                break;
+            case TRACE_OPTION:
+                Statistics::enableTracing();
+                trace = optarg;
+                break;
+            case DEPTH_LIMIT_OPTION:
+                depthLimit = parseCount('-', optarg, 1, UINT_MAX);
+                break;
+            case SIZE_LIMIT_OPTION:
+                sizeLimit = parseCount('-', optarg, 1, UINT_MAX);
+                break;
+            case LEMMA_LIMIT_OPTION:
+                lemmaLimit = parseCount('-', optarg, 1, UINT_MAX);
+                break;
             case '?':
-                throw IllegalOptionException(optopt);
+                throw IllegalOptionException(optopt == 0 ? '-' : optopt);
                 break;
             case ':':
-                throw MissingValueException(optopt);
+                throw MissingValueException(optopt > CHAR_MAX ? '-' : optopt);
                 break;
         }
     }
@@ -137,18 +305,81 @@ Configuration::Configuration(int argc,
     {
         system = new HilbertSystem();
     }
+    reader = new LineReader(input);
+}
+
+Configuration::Configuration(const string& inputSyntax,
+                             const string& outputSyntax,
+                             const string& outputLanguage)
+: echo(true)
+{
+    try
+    {
+        parser = inputSyntaxes.at(inputSyntax);
+        validator = inputValidators.at(inputSyntax);
+    } catch (out_of_range& exception)
+    {
+        throw IllegalValueException('i', inputSyntax);
+    }
+    try
+    {
+        printer = outputSyntaxes.at(outputSyntax);
+    } catch (out_of_range& exception)
+    {
+        throw IllegalValueException('o', outputSyntax);
+    }
+    try
+    {
+        language = outputLanguages.at(outputLanguage);
+    } catch (out_of_range& exception)
+    {
+        throw IllegalValueException('l', outputLanguage);
+    }
+    system = new HilbertSystem();
 }
 
 Configuration::~Configuration()
 {
-    if (file.is_open())
+    delete reader;
+    if (input != STDIN_FILENO)
     {
-        file.close();
+        close(input);
     }
     delete target;
     delete system;
 }
 
+Configuration* Configuration::derive() const
+{
+    Configuration* derived = new Configuration("infix", "infix", "ascii");
+
+    derived->parser = parser;
+    derived->validator = validator;
+    derived->printer = printer;
+    derived->language = language;
+    return derived;
+}
+
+void Configuration::setTarget(ExecutionTarget* target)
+{
+    delete this->target;
+    this->target = target;
+}
+
+void Configuration::setInput(const char* data,
+                             size_t size)
+{
+    delete reader;
+    reader = new LineReader(data, size);
+}
+
+void Configuration::setOutput(ostream& output,
+                              ostream& errors)
+{
+    this->output = &output;
+    this->errors = &errors;
+}
+
 ExecutionTarget* Configuration::getTarget() const
 {
     return target;
@@ -169,12 +400,108 @@ bool Configuration::getStrict() const
     return strict;
 }
 
-Formula* Configuration::parseFormula() const
+bool Configuration::getCertificate() const
+{
+    return certificate;
+}
+
+unsigned Configuration::getJobs() const
+{
+    return jobs;
+}
+
+unsigned Configuration::getDepthLimit() const
 {
-    return parser(*input);
+    return depthLimit;
+}
+
+unsigned Configuration::getSizeLimit() const
+{
+    return sizeLimit;
+}
+
+unsigned Configuration::getLemmaLimit() const
+{
+    return lemmaLimit;
+}
+
+const string& Configuration::getStatistics() const
+{
+    return statistics;
+}
+
+const string& Configuration::getTrace() const
+{
+    return trace;
+}
+
+LineReader* Configuration::getReader() const
+{
+    return reader;
+}
+
+ostream& Configuration::getOutput() const
+{
+    return *output;
+}
+
+ostream& Configuration::getErrors() const
+{
+    return *errors;
 }
 
 string Configuration::printFormula(Formula* formula) const
 {
-    return (formula->*printer)(language);
+    string buffer;
+
+    printFormula(formula, buffer);
+    return buffer;
+}
+
+bool Configuration::validateFormula(const Line& line,
+                                    ParseError& error) const
+{
+    PhaseTimer timer(PARSING);
+    bool valid = validator(line, error);
+
+    if (valid)
+    {
+        Statistics::count(FORMULAS_PARSED);
+    }
+    return valid;
+}
+
+void Configuration::printFormula(Formula* formula,
+                                 string& buffer) const
+{
+    PhaseTimer timer(PRINTING);
+
+    (formula->*printer)(language, buffer);
+}
+
+Formula* Configuration::parseFormula(const Line& line,
+                                     FormulaArena& arena) const
+{
+    ParseError error;
+    Formula* formula = parseFormula(line, arena, error);
+
+    if (error.failed())
+    {
+        error.raise();
+    }
+    return formula;
+}
+
+Formula* Configuration::parseFormula(const Line& line,
+                                     FormulaArena& arena,
+                                     ParseError& error) const
+{
+    PhaseTimer timer(PARSING);
+    Formula* formula = parser(line, arena, error);
+
+    if (formula != NULL)
+    {
+        Statistics::count(FORMULAS_PARSED);
+    }
+    return formula;
 }
@@ -1,23 +1,29 @@
 #ifndef CONFIGURATION_HPP
 #define	CONFIGURATION_HPP
 
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <string>
+#include <unistd.h>
 
 #include "formula.hpp"
+#include "formulaArena.hpp"
+#include "lineReader.hpp"
 #include "parseFormula.hpp"
 #include "proofSystem.hpp"
 
-using namespace std;
-
 class ExecutionTarget;
 
-typedef Formula* (*Parser)(istream&);
-///< Formula parse function pointer
+typedef Formula* (*Parser)(std::istream&, FormulaArena&);
+///< Formula stream parse function pointer
+
+typedef Formula* (*LineParser)(const Line&, FormulaArena&, ParseError&);
+///< Formula line parse function pointer
+
+typedef bool (*LineValidator)(const Line&, ParseError&);
+///< Formula line validate function pointer
 
-typedef string(Formula::*Printer)(Language) const;
+typedef void (Formula::*Printer)(Language, std::string&) const;
 ///< Formula print method pointer
 
 //! Program configuration structure
@@ -28,13 +34,16 @@ typedef string(Formula::*Printer)(Language) const;
 class Configuration
 {
 private:
-    static map<string, Parser> inputSyntaxes;
+    static std::map<std::string, LineParser> inputSyntaxes;
     ///< Input syntax values
 
-    static map<string, Printer> outputSyntaxes;
+    static std::map<std::string, LineValidator> inputValidators;
+    ///< Input syntax validators
+
+    static std::map<std::string, Printer> outputSyntaxes;
     ///< Output syntax values
 
-    static map<string, Language> outputLanguages;
+    static std::map<std::string, Language> outputLanguages;
     ///< Output language values
 
     ExecutionTarget* target = NULL;
@@ -49,25 +58,109 @@ private:
     bool strict = false;
     ///< Strict behaviour flag
 
-    istream* input = &cin;
-    ///< Input stream to read from
+    bool certificate = false;
+    ///< Certificate output flag
+
+    unsigned jobs = 1;
+    ///< Count of worker threads
+
+    unsigned depthLimit = 16;
+    ///< Greatest modus ponens nesting of a searched lemma
+
+    unsigned sizeLimit = 32;
+    ///< Greatest count of nodes of a searched axiom instance
+
+    unsigned lemmaLimit = 1 << 18;
+    ///< Greatest count of searched lemmas
+
+    std::string statistics;
+    ///< Statistics report file path, empty for the error output
 
-    ifstream file;
-    ///< File input stream to read from
+    std::string trace;
+    ///< Trace file path, empty when not tracing
 
-    Parser parser = &parseInfix;
+    int input = STDIN_FILENO;
+    ///< Input file descriptor to read from
+
+    LineReader* reader = NULL;
+    ///< Input lines reader
+
+    LineParser parser = &parseInfix;
     ///< Formula parser to use
 
+    LineValidator validator = &validateInfix;
+    ///< Formula validator to use
+
     Printer printer = &Formula::printInfix;
     ///< Formula printer to use
 
     Language language = ASCII;
     ///< Output language of connectives to use
+
+    std::ostream* output = &std::cout;
+    ///< Stream to print the results to
+
+    std::ostream* errors = &std::cerr;
+    ///< Stream to print the error messages to
 public:
     Configuration(int,
                   char**);
+
+    /**
+     * Creates an echoing configuration without a target and an input, to be
+     * set for each execution of an embedding program.
+     * @param inputSyntax Input syntax name
+     * @param outputSyntax Output syntax name
+     * @param outputLanguage Output language name
+     */
+    Configuration(const std::string& inputSyntax,
+                  const std::string& outputSyntax,
+                  const std::string& outputLanguage);
     ~Configuration();
 
+    /**
+     * Parses a count option value within given bounds, rejecting the negative
+     * values stoul would wrap around.
+     * @param option Option the value belongs to
+     * @param value Option value
+     * @param least Least count accepted
+     * @param greatest Greatest count accepted
+     * @return Count value
+     */
+    static unsigned parseCount(char option,
+                               const char* value,
+                               unsigned long least,
+                               unsigned long greatest);
+
+    /**
+     * Creates an echoing configuration without a target and an input, using
+     * the syntaxes of this one and a proof system of its own.
+     * @return Configuration owned by the caller
+     */
+    Configuration* derive() const;
+
+    /**
+     * Execution target setter.
+     * @param target Execution target to perform, owned by this configuration
+     */
+    void setTarget(ExecutionTarget* target);
+
+    /**
+     * Sets the input to characters held in memory.
+     * @param data Input characters, valid while being read
+     * @param size Count of input characters
+     */
+    void setInput(const char* data,
+                  size_t size);
+
+    /**
+     * Output streams setter.
+     * @param output Stream to print the results to
+     * @param errors Stream to print the error messages to
+     */
+    void setOutput(std::ostream& output,
+                   std::ostream& errors);
+
     /**
      * Execution target getter.
      * @return Execution target to perform
@@ -93,17 +186,111 @@ public:
     bool getStrict() const;
 
     /**
-     * Parses a formula.
+     * Certificate output flag getter.
+     * @return Certificate output flag
+     */
+    bool getCertificate() const;
+
+    /**
+     * Worker threads count getter.
+     * @return Count of worker threads
+     */
+    unsigned getJobs() const;
+
+    /**
+     * Search depth limit getter.
+     * @return Greatest modus ponens nesting of a searched lemma
+     */
+    unsigned getDepthLimit() const;
+
+    /**
+     * Search size limit getter.
+     * @return Greatest count of nodes of a searched axiom instance
+     */
+    unsigned getSizeLimit() const;
+
+    /**
+     * Search lemma limit getter.
+     * @return Greatest count of searched lemmas
+     */
+    unsigned getLemmaLimit() const;
+
+    /**
+     * Statistics report file path getter.
+     * @return Statistics report file path, empty for the error output
+     */
+    const std::string& getStatistics() const;
+
+    /**
+     * Trace file path getter.
+     * @return Trace file path, empty when not tracing
+     */
+    const std::string& getTrace() const;
+
+    /**
+     * Input lines reader getter.
+     * @return Input lines reader
+     */
+    LineReader* getReader() const;
+
+    /**
+     * Results stream getter.
+     * @return Stream to print the results to
+     */
+    std::ostream& getOutput() const;
+
+    /**
+     * Error messages stream getter.
+     * @return Stream to print the error messages to
+     */
+    std::ostream& getErrors() const;
+
+    /**
+     * Parses a formula from given line.
+     * @param line Input line to parse
+     * @param arena Arena to allocate the formula in
      * @return Formula expression tree root node
      */
-    Formula* parseFormula() const;
+    Formula* parseFormula(const Line& line,
+                          FormulaArena& arena) const;
+
+    /**
+     * Parses a formula from given line without throwing.
+     * @param line Input line to parse
+     * @param arena Arena to allocate the formula in
+     * @param error Storage for the parse failure
+     * @return Formula expression tree root node, NULL if the line is empty
+     * or on failure
+     */
+    Formula* parseFormula(const Line& line,
+                          FormulaArena& arena,
+                          ParseError& error) const;
+
+    /**
+     * Verifies that given line holds a formula without building it or
+     * throwing.
+     * @param line Input line to validate
+     * @param error Storage for the parse failure
+     * @return True if the line holds a formula, false if it is empty or on
+     * failure
+     */
+    bool validateFormula(const Line& line,
+                         ParseError& error) const;
 
     /**
      * Returns a textual representation of given formula.
      * @param formula Formula to be printed
      * @return Textual representation of given formula
      */
-    string printFormula(Formula* formula) const;
+    std::string printFormula(Formula* formula) const;
+
+    /**
+     * Appends a textual representation of given formula to a buffer.
+     * @param formula Formula to be printed
+     * @param buffer Buffer to append the representation to
+     */
+    void printFormula(Formula* formula,
+                      std::string& buffer) const;
 };
 
 #endif
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <sstream>
+#include <stdlib.h>
+
+#include "configuration.hpp"
+#include "context.hpp"
+#include "executionTarget.hpp"
+#include "formulaArena.hpp"
+#include "formulaStore.hpp"
+#include "parseException.hpp"
+
+using namespace std;
+
+//! Parse text
+
+/**
+ * Parses the formula of a text held in memory. The newlines are read as
+ * blanks, so that any text past the first one is parsed as well instead of
+ * being ignored.
+ * @param config Configuration to parse with
+ * @param text Formula text
+ * @param arena Arena to allocate the formula in
+ * @return Formula expression tree root node
+ */
+static Formula* parseText(const Configuration& config,
+                          const string& text,
+                          FormulaArena& arena)
+{
+    string joined;
+    const string* whole = &text;
+
+    if (text.find('\n') != string::npos)
+    {
+        joined = text;
+        replace(joined.begin(), joined.end(), '\n', ' ');
+        whole = &joined;
+    }
+
+    Formula* formula = config.parseFormula({whole->data(), whole->data() + whole->size(), true}, arena);
+
+    if (formula == NULL)
+    {
+        ParseError(INCOMPLETE_FORMULA).raise();
+    }
+    return formula;
+}
+
+Context::Context(const string& inputSyntax,
+                 const string& outputSyntax,
+                 const string& outputLanguage)
+: config(new Configuration(inputSyntax, outputSyntax, outputLanguage)),
+  arena(new FormulaArena()), store(new FormulaStore())
+{
+}
+
+Context::Context(const Configuration& base)
+: config(base.derive()),
+  arena(new FormulaArena()), store(new FormulaStore())
+{
+}
+
+Context::~Context()
+{
+    delete store;
+    delete arena;
+    delete config;
+}
+
+bool Context::execute(ExecutionTarget* target,
+                      const string& input,
+                      string& output)
+{
+    ostringstream stream;
+    string terminated;
+    const string* lines = &input;
+    int exit;
+
+    // The last line is taken as complete even without a newline
+    if (!input.empty() && input.back() != '\n')
+    {
+        terminated = input + '\n';
+        lines = &terminated;
+    }
+    config->setTarget(target);
+    config->setInput(lines->data(), lines->size());
+    config->setOutput(stream, stream);
+    exit = target->execute(*config);
+    output = stream.str();
+    if (store->size() > STORE_LIMIT)
+    {
+        store->clear();
+    }
+    return exit == EXIT_SUCCESS;
+}
+
+bool Context::parse(const string& formula,
+                    string& error)
+{
+    try
+    {
+        parseText(*config, formula, *arena);
+        arena->reset();
+        return true;
+    } catch (ParseException& exception)
+    {
+        error = exception.getMessage();
+        arena->reset();
+        return false;
+    }
+}
+
+bool Context::print(const string& formula,
+                    string& output)
+{
+    try
+    {
+        output.clear();
+        config->printFormula(parseText(*config, formula, *arena), output);
+        arena->reset();
+        return true;
+    } catch (ParseException& exception)
+    {
+        output = exception.getMessage();
+        arena->reset();
+        return false;
+    }
+}
+
+unsigned Context::isAxiom(const string& formula,
+                          string& error)
+{
+    try
+    {
+        unsigned type = config->getSystem()->isAxiom(parseText(*config, formula, *arena));
+        arena->reset();
+        return type;
+    } catch (ParseException& exception)
+    {
+        error = exception.getMessage();
+        arena->reset();
+        return 0;
+    }
+}
+
+bool Context::verify(const string& proof,
+                     unsigned premises,
+                     string& output)
+{
+    return execute(new ProofHandler(premises, VERIFY, store), proof, output);
+}
+
+bool Context::minimize(const string& proof,
+                       unsigned premises,
+                       string& output)
+{
+    return execute(new ProofHandler(premises, MINIMIZE, store), proof, output);
+}
@@ -0,0 +1,116 @@
+#ifndef CONTEXT_HPP
+#define	CONTEXT_HPP
+
+#include <string>
+
+class Configuration;
+class ExecutionTarget;
+class FormulaArena;
+class FormulaStore;
+
+//! Embedding context
+
+/**
+ * Library interface handling formulas and proofs held in memory. The proof
+ * system and the formula store are set up once per context, which serves one
+ * thread at a time.
+ */
+class Context
+{
+private:
+    static const size_t STORE_LIMIT = 1 << 20;
+    ///< Count of shared nodes past which the store is cleared after a call
+
+    Configuration* config;
+    ///< Configuration shared by the calls
+
+    FormulaArena* arena;
+    ///< Arena of the formulas parsed by a call
+
+    FormulaStore* store;
+    ///< Store sharing the proof formulas across the calls
+
+    /**
+     * Executes a target over given input.
+     * @param target Execution target, owned by this context from now on
+     * @param input Input lines, the last one possibly without a newline
+     * @param output Storage for the results and the error messages
+     * @return True if the target succeeded
+     */
+    bool execute(ExecutionTarget* target,
+                 const std::string& input,
+                 std::string& output);
+public:
+    /**
+     * Creates a context, throwing IllegalValueException for an unknown name.
+     * @param inputSyntax Input syntax name as of the -i option
+     * @param outputSyntax Output syntax name as of the -o option
+     * @param outputLanguage Output language name as of the -l option
+     */
+    Context(const std::string& inputSyntax = "infix",
+            const std::string& outputSyntax = "infix",
+            const std::string& outputLanguage = "ascii");
+
+    /**
+     * Creates a context using the syntaxes of a configuration.
+     * @param base Configuration to take the syntaxes from
+     */
+    Context(const Configuration& base);
+    Context(const Context&) = delete;
+    ~Context();
+
+    Context& operator=(const Context&) = delete;
+
+    /**
+     * Verifies whether a formula is well formed.
+     * @param formula Formula in the input syntax
+     * @param error Storage for the parse error message
+     * @return True if given formula is well formed
+     */
+    bool parse(const std::string& formula,
+               std::string& error);
+
+    /**
+     * Prints a formula in the output syntax and language.
+     * @param formula Formula in the input syntax
+     * @param output Storage for the printed formula or the parse error message
+     * @return True if given formula is well formed
+     */
+    bool print(const std::string& formula,
+               std::string& output);
+
+    /**
+     * Verifies whether a formula is an axiom.
+     * @param formula Formula in the input syntax
+     * @param error Storage for the parse error message
+     * @return Axiom type given formula is or 0 when it is not an axiom
+     */
+    unsigned isAxiom(const std::string& formula,
+                     std::string& error);
+
+    /**
+     * Verifies a proof as the -P option does.
+     * @param proof Premises and proof lines, possibly annotated, the last one
+     * possibly without a newline
+     * @param premises Count of the premises
+     * @param output Storage for the verification messages
+     * @return True if given proof is valid
+     */
+    bool verify(const std::string& proof,
+                unsigned premises,
+                std::string& output);
+
+    /**
+     * Minimizes a proof as the -M option does.
+     * @param proof Premises and proof lines, possibly annotated, the last one
+     * possibly without a newline
+     * @param premises Count of the premises
+     * @param output Storage for the minimized proof or the error messages
+     * @return True if given proof got minimized
+     */
+    bool minimize(const std::string& proof,
+                  unsigned premises,
+                  std::string& output);
+};
+
+#endif
@@ -1,184 +1,574 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <stdlib.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "annotation.hpp"
+#include "bddManager.hpp"
 #include "executionTarget.hpp"
+#include "flatFormula.hpp"
 #include "formula.hpp"
+#include "formulaStore.hpp"
 #include "parseException.hpp"
+#include "proofSearch.hpp"
 #include "proofSystem.hpp"
+#include "satSolver.hpp"
+#include "socketServer.hpp"
+#include "statistics.hpp"
+#include "truthTable.hpp"
+#include "tseitinEncoder.hpp"
+
+using namespace std;
 
 ExecutionTarget::~ExecutionTarget()
 {
 }
 
-int AxiomChecker::execute(Configuration& config) const
+void ExecutionTarget::printCertificate(const Configuration& config,
+                                       const vector<Formula*>& theory,
+                                       const vector<ProofMember*>& proof,
+                                       bool preservedOnly) const
+{
+    unordered_map<ProofMember*, unsigned> positions;
+    string buffer;
+
+    for (Formula* premise : theory)
+    {
+        config.printFormula(premise, buffer);
+        buffer += '\n';
+    }
+    for (ProofMember* member : proof)
+    {
+        if (preservedOnly && !member->getPreserve())
+        {
+            continue;
+        }
+        positions.emplace(member, positions.size() + 1);
+        config.printFormula(member->getFormula(), buffer);
+        switch (member->getJustification())
+        {
+            case AXIOM:
+                buffer += " ; AX " + to_string(member->getType());
+                break;
+            case PREMISE:
+                buffer += " ; PR " + to_string(member->getType());
+                break;
+            case MODUS_PONENS:
+                buffer += " ; MP";
+                for (ProofMember* witness : member->getWitnesses())
+                {
+                    buffer += " " + to_string(positions.at(witness));
+                }
+                break;
+            case SEARCH:
+                break;
+        }
+        buffer += '\n';
+    }
+    config.getOutput() << buffer;
+    config.getOutput().flush();
+}
+
+int LineTarget::execute(Configuration& config) const
+{
+    LinePipeline pipeline(config, *this);
+
+    return pipeline.run();
+}
+
+void AxiomChecker::process(const Configuration& config,
+                           const Line& line,
+                           FormulaArena& arena,
+                           LineResult& result) const
+{
+    ParseError error;
+
+    // Formula parsing
+    Formula* formula = config.parseFormula(line, arena, error);
+    if (error.failed())
+    {
+        if (config.getEcho())
+        {
+            result.error = error.getMessage() + "\n";
+        }
+        result.failure = true;
+        return;
+    } else if (formula == NULL)
+    {
+        result.end = true;
+        return;
+    }
+
+    // Axiom checking
+    unsigned type = config.getSystem()->isAxiom(formula);
+    if (type > 0)
+    {
+        if (config.getEcho())
+        {
+            result.output = "Axiom of type " + to_string(type) + ".\n";
+        }
+    } else
+    {
+        if (config.getEcho())
+        {
+            result.output = "Not an axiom.\n";
+        }
+        result.failure = true;
+    }
+}
+
+TruthTableChecker::TruthTableChecker()
+: borrowed(0)
+{
+}
+
+unsigned TruthTableChecker::borrow(unsigned spare) const
+{
+    unsigned taken = borrowed.load();
+
+    while (taken < spare && !borrowed.compare_exchange_weak(taken, spare))
+    {
+    }
+    return taken < spare ? spare - taken : 0;
+}
+
+void TruthTableChecker::process(const Configuration& config,
+                                const Line& line,
+                                FormulaArena& arena,
+                                LineResult& result) const
+{
+    ParseError error;
+
+    // Formula parsing
+    Formula* formula = config.parseFormula(line, arena, error);
+    if (error.failed())
+    {
+        if (config.getEcho())
+        {
+            result.error = error.getMessage() + "\n";
+        }
+        result.failure = true;
+        return;
+    } else if (formula == NULL)
+    {
+        result.end = true;
+        return;
+    }
+
+    // Truth table evaluation, the threads beyond the line's own borrowed
+    // from a budget shared by the lines handled in parallel
+    TruthTable table((FlatFormula(formula)));
+    unsigned lent = table.isParallel() ? borrow(config.getJobs() - 1) : 0;
+    Satisfiability satisfiability = table.evaluate(1 + lent);
+    borrowed -= lent;
+    switch (satisfiability)
+    {
+        case TAUTOLOGY:
+            if (config.getEcho())
+            {
+                result.output = "Tautology.\n";
+            }
+            break;
+        case SATISFIABLE:
+            if (config.getEcho())
+            {
+                result.output = "Satisfiable.\n";
+            }
+            result.failure = true;
+            break;
+        case UNSATISFIABLE:
+            if (config.getEcho())
+            {
+                result.output = "Unsatisfiable.\n";
+            }
+            result.failure = true;
+            break;
+    }
+}
+
+DiagramHandler::DiagramHandler(DiagramTarget target)
+: target(target)
+{
+}
+
+int DiagramHandler::execute(Configuration& config) const
 {
     int exit = EXIT_SUCCESS;
+    FormulaArena arena;
+    BddManager manager;
+    Line line;
+    unsigned number = 0;
+    unsigned pending = BddManager::FALSE;
+    bool paired = false;
+    bool valid = false;
 
-    while (true)
+    while (config.getReader()->next(line))
     {
+        Statistics::setLine(++number);
+        PhaseTimer timer(HANDLING);
+
         try
         {
             // Formula parsing
-            Formula* formula = config.parseFormula();
+            Formula* formula = config.parseFormula(line, arena);
             if (formula == NULL)
             {
                 break;
             }
 
-            // Axiom checking
-            unsigned type = config.getSystem()->isAxiom(formula);
-            delete formula;
-            if (type > 0)
+            // Diagram handling
+            unsigned diagram = manager.build(formula);
+            bool success = true;
+            switch (target)
             {
-                if (config.getEcho())
-                {
-                    cout << "Axiom of type " << type << "." << endl;
-                }
-            } else
+                case DECIDE:
+                    success = diagram == BddManager::TRUE;
+                    if (config.getEcho())
+                    {
+                        config.getOutput() << (success ? "Tautology."
+                                               : diagram == BddManager::FALSE ? "Unsatisfiable."
+                                               : "Satisfiable.") << endl;
+                    }
+                    break;
+                case COMPARE:
+                    if (!paired)
+                    {
+                        pending = diagram;
+                        manager.reference(pending);
+                        valid = true;
+                    } else if (valid)
+                    {
+                        success = diagram == pending;
+                        if (config.getEcho())
+                        {
+                            config.getOutput() << (success ? "Equivalent." : "Not equivalent.") << endl;
+                        }
+                        manager.dereference(pending);
+                    }
+                    paired = !paired;
+                    break;
+                case COUNT:
+                    if (config.getEcho())
+                    {
+                        FlatFormula flat(formula);
+                        bool propositions['Z' - 'A' + 1] = {false};
+                        unsigned variables = 0;
+                        for (unsigned position = 0; position < flat.size(); position++)
+                        {
+                            char code = flat.getCode(position);
+                            if (code >= 'A' && code <= 'Z' && !propositions[code - 'A'])
+                            {
+                                propositions[code - 'A'] = true;
+                                variables++;
+                            }
+                        }
+                        config.getOutput() << manager.countModels(diagram, variables) << endl;
+                    }
+                    break;
+            }
+            arena.reset();
+            manager.collect();
+            if (!success)
             {
-                if (config.getEcho())
-                {
-                    cout << "Not an axiom." << endl;
-                }
                 exit = EXIT_FAILURE;
                 if (config.getStrict())
                 {
-                    break;
+                    return exit;
                 }
             }
         } catch (ParseException& exception)
         {
             if (config.getEcho())
             {
-                cerr << exception.getMessage() << endl;
+                config.getErrors() << exception.getMessage() << endl;
+            }
+            arena.reset();
+            if (target == COMPARE)
+            {
+                if (paired && valid)
+                {
+                    manager.dereference(pending);
+                }
+                valid = false;
+                paired = !paired;
             }
             exit = EXIT_FAILURE;
             if (config.getStrict())
             {
-                break;
+                return exit;
             }
         }
     }
+
+    // Incomplete pair checking
+    if (target == COMPARE && paired)
+    {
+        if (config.getEcho())
+        {
+            config.getErrors() << "Unpaired formula." << endl;
+        }
+        exit = EXIT_FAILURE;
+    }
     return exit;
 }
 
-int DefaultTarget::execute(Configuration& config) const
+int SatisfiabilityChecker::execute(Configuration& config) const
 {
     int exit = EXIT_SUCCESS;
+    FormulaArena arena;
+    SatSolver solver;
+    TseitinEncoder encoder(solver);
+    vector<unsigned> variables;
+    Line line;
+    unsigned number = 0;
 
-    while (true)
+    while (config.getReader()->next(line))
     {
+        Statistics::setLine(++number);
+        PhaseTimer timer(HANDLING);
+
         try
         {
             // Formula parsing
-            Formula* formula = config.parseFormula();
+            Formula* formula = config.parseFormula(line, arena);
             if (formula == NULL)
             {
                 break;
             }
 
-            // Formula printing
+            // Formula solving under the assumptions of its falsity and truth
+            Literal literal = encoder.encode(formula, variables);
+            arena.reset();
+            if (!solver.solve({SatSolver::negate(literal)}, variables))
+            {
+                if (config.getEcho())
+                {
+                    config.getOutput() << "Tautology." << endl;
+                }
+                continue;
+            }
             if (config.getEcho())
             {
-                cout << config.printFormula(formula) << endl;
+                config.getOutput() << (solver.solve({literal}, variables)
+                                       ? "Satisfiable." : "Unsatisfiable.") << endl;
             }
-            delete formula;
         } catch (ParseException& exception)
         {
             if (config.getEcho())
             {
-                cerr << exception.getMessage() << endl;
-            }
-            exit = EXIT_FAILURE;
-            if (config.getStrict())
-            {
-                break;
+                config.getErrors() << exception.getMessage() << endl;
             }
+            arena.reset();
+        }
+        exit = EXIT_FAILURE;
+        if (config.getStrict())
+        {
+            break;
         }
     }
     return exit;
 }
 
+void DefaultTarget::process(const Configuration& config,
+                            const Line& line,
+                            FormulaArena& arena,
+                            LineResult& result) const
+{
+    ParseError error;
+
+    // Formula parsing
+    Formula* formula = config.parseFormula(line, arena, error);
+    if (error.failed())
+    {
+        if (config.getEcho())
+        {
+            result.error = error.getMessage() + "\n";
+        }
+        result.failure = true;
+        return;
+    } else if (formula == NULL)
+    {
+        result.end = true;
+        return;
+    }
+
+    // Formula printing
+    if (config.getEcho())
+    {
+        config.printFormula(formula, result.output);
+        result.output += '\n';
+    }
+}
+
+void FormulaValidator::process(const Configuration& config,
+                               const Line& line,
+                               FormulaArena& arena,
+                               LineResult& result) const
+{
+    ParseError error;
+
+    // Formula validation
+    bool valid = config.validateFormula(line, error);
+    if (error.failed())
+    {
+        if (config.getEcho())
+        {
+            result.error = error.getMessage() + "\n";
+        }
+        result.failure = true;
+        return;
+    } else if (!valid)
+    {
+        result.end = true;
+        return;
+    }
+    if (config.getEcho())
+    {
+        result.output = "Valid formula.\n";
+    }
+}
+
 ProofHandler::ProofHandler(unsigned premises,
-                           ProofTarget target)
-: premises(premises), target(target)
+                           ProofTarget target,
+                           FormulaStore* store)
+: premises(premises), target(target), store(store)
 {
 }
 
 int ProofHandler::execute(Configuration& config) const
 {
     int exit = EXIT_SUCCESS;
-    list<Formula*> theory;
+    FormulaArena arena;
+    FormulaStore local;
+    FormulaStore& store = this->store != NULL ? *this->store : local;
+    vector<Formula*> theory;
     vector<ProofMember*> proof;
+    ProofIndex index(proof);
+    Line line;
+    unsigned number = 0;
+    bool messages = target == VERIFY && config.getEcho() && !config.getCertificate();
 
-    while (true)
+    while (config.getReader()->next(line))
     {
+        Statistics::setLine(++number);
+        PhaseTimer timer(HANDLING);
+
         try
         {
             // Formula parsing
-            Formula* formula = config.parseFormula();
-            if (formula == NULL)
+            Annotation annotation(line);
+            Formula* parsed = config.parseFormula(line, arena);
+            if (parsed == NULL)
             {
                 break;
             }
+            Formula* formula = store.intern(parsed);
+            arena.reset();
             if (theory.size() < premises)
             {
+                if (annotation.getJustification() != SEARCH)
+                {
+                    ParseError(INVALID_ANNOTATION).raise();
+                }
                 theory.push_back(formula);
                 continue;
             }
 
-            // Axiom checking
-            unsigned type = config.getSystem()->isAxiom(formula);
-            if (type > 0)
+            // Justification checking
+            unsigned axiom = 0;
+            unsigned premise = 0;
+            list<unsigned> indexes;
+            switch (annotation.getJustification())
             {
-                if (target == VERIFY && config.getEcho())
+                case AXIOM:
+                    if (config.getSystem()->isAxiom(formula, annotation.getIndexes().front()))
+                    {
+                        axiom = annotation.getIndexes().front();
+                    }
+                    break;
+                case PREMISE:
                 {
-                    cout << "Axiom of type " << type << "." << endl;
+                    PhaseTimer timer(PREMISE_CHECKING);
+                    premise = annotation.getIndexes().front();
+                    if (premise == 0 || premise > theory.size()
+                        || !formula->equals(theory[premise - 1]))
+                    {
+                        premise = 0;
+                    }
+                    break;
                 }
-                proof.push_back(new ProofMember(formula));
-                continue;
+                case MODUS_PONENS:
+                    if (config.getSystem()->isDeducible(formula, proof, annotation.getIndexes()))
+                    {
+                        indexes = annotation.getIndexes();
+                    }
+                    break;
+                case SEARCH:
+                    axiom = config.getSystem()->isAxiom(formula);
+                    if (axiom == 0)
+                    {
+                        PhaseTimer timer(PREMISE_CHECKING);
+                        for (unsigned type = 1; type <= theory.size(); type++)
+                        {
+                            if (formula->equals(theory[type - 1]))
+                            {
+                                premise = type;
+                                break;
+                            }
+                        }
+                    }
+                    if (axiom == 0 && premise == 0)
+                    {
+                        indexes = config.getSystem()->isDeducible(formula, proof, index);
+                    }
+                    break;
             }
 
-            // Theory member checking
-            type = 1;
-            for (Formula* premise : theory)
+            // Axiom found
+            if (axiom > 0)
             {
-                if (formula->equals(premise))
+                if (messages)
                 {
-                    break;
+                    config.getOutput() << "Axiom of type " << axiom << "." << endl;
                 }
-                type++;
+                proof.push_back(new ProofMember(formula, AXIOM, axiom));
+                continue;
             }
-            if (type <= theory.size())
+
+            // Theory member found
+            if (premise > 0)
             {
-                if (target == VERIFY && config.getEcho())
+                if (messages)
                 {
-                    cout << "Premise of type " << type << "." << endl;
+                    config.getOutput() << "Premise of type " << premise << "." << endl;
                 }
-                proof.push_back(new ProofMember(formula));
+                proof.push_back(new ProofMember(formula, PREMISE, premise));
                 continue;
             }
 
-            // Deduction checking
-            list<unsigned> indexes = config.getSystem()->isDeducible(formula, proof);
+            // Deduction found
             if (!indexes.empty())
             {
-                if (target == VERIFY && config.getEcho())
+                if (messages)
                 {
-                    cout << "Deducible using formulas ";
+                    config.getOutput() << "Deducible using formulas ";
                     for (unsigned index : indexes)
                     {
-                        cout << index << " ";
+                        config.getOutput() << index << " ";
                     }
-                    cout << "as witnesses." << endl;
+                    config.getOutput() << "as witnesses." << endl;
                 }
                 list<ProofMember*> witnesses;
                 for (unsigned index : indexes)
                 {
                     witnesses.push_back(proof[index - 1]);
                 }
-                proof.push_back(new ProofMember(formula, witnesses));
+                proof.push_back(new ProofMember(formula, MODUS_PONENS, 0, witnesses));
                 continue;
             }
 
@@ -188,15 +578,14 @@ int ProofHandler::execute(Configuration& config) const
                 switch (target)
                 {
                     case VERIFY:
-                        cout << "Formula not deducible." << endl;
+                        config.getOutput() << "Formula not deducible." << endl;
                         break;
                     case MINIMIZE:
-                        cerr << "Invalid proof given." << endl;
+                        config.getErrors() << "Invalid proof given." << endl;
                         break;
                 }
             }
             exit = EXIT_FAILURE;
-            delete formula;
             break;
         } catch (ParseException& exception)
         {
@@ -205,10 +594,10 @@ int ProofHandler::execute(Configuration& config) const
                 switch (target)
                 {
                     case VERIFY:
-                        cerr << exception.getMessage() << endl;
+                        config.getErrors() << exception.getMessage() << endl;
                         break;
                     case MINIMIZE:
-                        cerr << "Invalid formula " << proof.size() + 1 << "." << endl;
+                        config.getErrors() << "Invalid formula " << proof.size() + 1 << "." << endl;
                         break;
                 }
             }
@@ -217,53 +606,204 @@ int ProofHandler::execute(Configuration& config) const
         }
     }
 
+    // Certificate output
+    if (exit == EXIT_SUCCESS && target == VERIFY
+        && config.getCertificate() && config.getEcho())
+    {
+        printCertificate(config, theory, proof, false);
+    }
+
     // Proof minimization
     if (exit == EXIT_SUCCESS && target == MINIMIZE && !proof.empty())
     {
-        list<ProofMember*> queue;
+        PhaseTimer timer(MINIMIZING);
+        vector<uint64_t> costs(proof.size(), 0);
+        vector<ProofMember*> pending;
         unsigned preserved = 0;
 
-        queue.push_back(proof.back());
-        while (!queue.empty())
+        // Cheapest witnesses selection, duplicates left to the first occurrence.
+        // Costs count the lines of a sub-proof as a tree, so a shared lemma
+        // is counted once per use. Counting distinct lines would take time
+        // quadratic in the proof length. A chain of lines each using the one
+        // before twice doubles the cost per line, so costs saturate at the
+        // maximum and the witnesses of such lines fall back to the first pair.
+        index.update();
+        for (unsigned position = 0; position < proof.size(); position++)
         {
-            for (ProofMember* witness : queue.front()->getWitnesses())
+            ProofMember* member = proof[position];
+            if (index.findMember(member->getFormula()) <= position)
+            {
+                continue;
+            }
+            costs[position] = 1;
+            if (member->getWitnesses().empty())
             {
-                queue.push_back(witness);
+                continue;
             }
-            queue.front()->setPreserve(true);
-            queue.pop_front();
+            list<ProofMember*> witnesses;
+            uint64_t cheapest = 0;
+            for (const list<unsigned>& deduction
+                 : config.getSystem()->findDeductions(member->getFormula(),
+                                                      proof,
+                                                      index,
+                                                      position))
+            {
+                uint64_t cost = 1;
+                for (unsigned witness : deduction)
+                {
+                    cost += min(costs[witness - 1], numeric_limits<uint64_t>::max() - cost);
+                }
+                if (cheapest == 0 || cost < cheapest)
+                {
+                    cheapest = cost;
+                    witnesses.clear();
+                    for (unsigned witness : deduction)
+                    {
+                        witnesses.push_back(proof[witness - 1]);
+                    }
+                }
+            }
+            costs[position] = cheapest;
+            member->setWitnesses(witnesses);
+        }
+
+        // Witnesses traversal visiting each member once
+        pending.push_back(proof[index.findMember(proof.back()->getFormula()) - 1]);
+        while (!pending.empty())
+        {
+            ProofMember* member = pending.back();
+            pending.pop_back();
+            Statistics::count(MINIMIZATION_VISITS);
+            if (member->getPreserve())
+            {
+                continue;
+            }
+            member->setPreserve(true);
             preserved++;
+            for (ProofMember* witness : member->getWitnesses())
+            {
+                pending.push_back(witness);
+            }
         }
         if (preserved == proof.size())
         {
             if (config.getEcho())
             {
-                cerr << "Proof already minimal." << endl;
+                config.getErrors() << "Proof already minimal." << endl;
             }
             exit = EXIT_FAILURE;
-        } else
+        } else if (config.getCertificate())
         {
             if (config.getEcho())
             {
-                for (ProofMember* member : proof)
+                printCertificate(config, theory, proof, true);
+            }
+        } else if (config.getEcho())
+        {
+            for (ProofMember* member : proof)
+            {
+                if (member->getPreserve())
                 {
-                    if (member->getPreserve())
-                    {
-                        cout << config.printFormula(member->getFormula()) << endl;
-                    }
+                    config.getOutput() << config.printFormula(member->getFormula()) << endl;
                 }
             }
         }
     }
 
     // Cleanup
-    for (Formula* formula : theory)
-    {
-        delete formula;
-    }
     for (ProofMember* member : proof)
     {
         delete member;
     }
     return exit;
 }
+
+ProofSearcher::ProofSearcher(unsigned premises)
+: premises(premises)
+{
+}
+
+int ProofSearcher::execute(Configuration& config) const
+{
+    int exit = EXIT_SUCCESS;
+    FormulaArena arena;
+    FormulaStore store;
+    ProofSearch search(config);
+    vector<Formula*> theory;
+    Line line;
+    unsigned number = 0;
+    bool separate = false;
+
+    while (config.getReader()->next(line))
+    {
+        Statistics::setLine(++number);
+        PhaseTimer timer(HANDLING);
+
+        try
+        {
+            // Formula parsing
+            Formula* formula = config.parseFormula(line, arena);
+            if (formula == NULL)
+            {
+                break;
+            }
+            if (theory.size() < premises)
+            {
+                theory.push_back(store.intern(formula));
+                search.addPremise(formula);
+                arena.reset();
+                continue;
+            }
+
+            // Goal proving
+            vector<ProofMember*> proof = search.prove(formula);
+            arena.reset();
+            if (!proof.empty())
+            {
+                if (config.getEcho())
+                {
+                    if (separate)
+                    {
+                        config.getOutput() << endl;
+                    }
+                    printCertificate(config, theory, proof, false);
+                    separate = true;
+                }
+                for (ProofMember* member : proof)
+                {
+                    delete member;
+                }
+                continue;
+            }
+            if (config.getEcho())
+            {
+                config.getOutput() << "Proof not found." << endl;
+            }
+        } catch (ParseException& exception)
+        {
+            if (config.getEcho())
+            {
+                config.getErrors() << exception.getMessage() << endl;
+            }
+            arena.reset();
+        }
+        exit = EXIT_FAILURE;
+        if (config.getStrict())
+        {
+            break;
+        }
+    }
+    return exit;
+}
+
+RequestServer::RequestServer(const string& path)
+: path(path)
+{
+}
+
+int RequestServer::execute(Configuration& config) const
+{
+    SocketServer server(config, path);
+
+    return server.run();
+}
@@ -1,9 +1,16 @@
 #ifndef EXECUTION_TARGET_HPP
 #define	EXECUTION_TARGET_HPP
 
-#include "configuration.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
 
-using namespace std;
+#include "configuration.hpp"
+#include "formulaArena.hpp"
+#include "formulaStore.hpp"
+#include "linePipeline.hpp"
+#include "lineReader.hpp"
+#include "proofMember.hpp"
 
 //! Proof handler target
 
@@ -16,6 +23,18 @@ enum ProofTarget
     MINIMIZE ///< Minimize the verified proof
 };
 
+//! Diagram handler target
+
+/**
+ * Targets of the diagram handler target.
+ */
+enum DiagramTarget
+{
+    DECIDE, ///< Decide whether each formula is a tautology
+    COMPARE, ///< Decide whether consecutive formula pairs are equivalent
+    COUNT ///< Count the satisfying assignments of each formula
+};
+
 //! Program execution target
 
 /**
@@ -23,6 +42,19 @@ enum ProofTarget
  */
 class ExecutionTarget
 {
+protected:
+    /**
+     * Prints the premises and the proof annotated with the justifications,
+     * re-checkable without any search.
+     * @param config Program configuration to print formulas with
+     * @param theory Premises preceding the proof
+     * @param proof Verified proof to be printed
+     * @param preservedOnly True to print only minimal proof components
+     */
+    void printCertificate(const Configuration& config,
+                          const std::vector<Formula*>& theory,
+                          const std::vector<ProofMember*>& proof,
+                          bool preservedOnly) const;
 public:
     virtual ~ExecutionTarget();
 
@@ -34,12 +66,91 @@ public:
     virtual int execute(Configuration& config) const = 0;
 };
 
+//! Line by line execution target
+
+/**
+ * Target handling each input line on its own, possibly in parallel.
+ */
+class LineTarget: public ExecutionTarget
+{
+public:
+    virtual int execute(Configuration&) const;
+
+    /**
+     * Handles one input line, safely from several threads at once.
+     * @param config Program configuration
+     * @param line Input line to be handled
+     * @param arena Arena to allocate formulas in
+     * @param result Result of the line to be filled in
+     */
+    virtual void process(const Configuration& config,
+                         const Line& line,
+                         FormulaArena& arena,
+                         LineResult& result) const = 0;
+};
+
 //! Axiom verification
 
 /**
  * Verify each formula as an axiom.
  */
-class AxiomChecker: public ExecutionTarget
+class AxiomChecker: public LineTarget
+{
+public:
+    virtual void process(const Configuration&,
+                         const Line&,
+                         FormulaArena&,
+                         LineResult&) const;
+};
+
+//! Truth table verification
+
+/**
+ * Evaluate each formula under all assignments of its propositions.
+ */
+class TruthTableChecker: public LineTarget
+{
+private:
+    mutable std::atomic<unsigned> borrowed;
+    ///< Count of threads lent to the lines beyond their own
+
+    /**
+     * Lends the threads not lent yet, safely from several threads at once.
+     * @param spare Count of threads to be lent in total
+     * @return Count of threads lent
+     */
+    unsigned borrow(unsigned spare) const;
+public:
+    TruthTableChecker();
+
+    virtual void process(const Configuration&,
+                         const Line&,
+                         FormulaArena&,
+                         LineResult&) const;
+};
+
+//! Decision diagrams handling
+
+/**
+ * Convert the formulas to decision diagrams sharing one manager.
+ */
+class DiagramHandler: public ExecutionTarget
+{
+private:
+    DiagramTarget target;
+    ///< Diagram handler target
+public:
+    DiagramHandler(DiagramTarget);
+
+    virtual int execute(Configuration&) const;
+};
+
+//! Satisfiability verification
+
+/**
+ * Decide each formula by a satisfiability solver shared across the input.
+ */
+class SatisfiabilityChecker: public ExecutionTarget
 {
 public:
     virtual int execute(Configuration&) const;
@@ -50,10 +161,27 @@ public:
 /**
  * Parse formulas only.
  */
-class DefaultTarget: public ExecutionTarget
+class DefaultTarget: public LineTarget
 {
 public:
-    virtual int execute(Configuration&) const;
+    virtual void process(const Configuration&,
+                         const Line&,
+                         FormulaArena&,
+                         LineResult&) const;
+};
+
+//! Formula validation
+
+/**
+ * Verify the syntax of each formula without building it.
+ */
+class FormulaValidator: public LineTarget
+{
+public:
+    virtual void process(const Configuration&,
+                         const Line&,
+                         FormulaArena&,
+                         LineResult&) const;
 };
 
 //! Proof handling
@@ -69,9 +197,51 @@ private:
 
     ProofTarget target;
     ///< Proof handler target
+
+    FormulaStore* store;
+    ///< Store sharing the formulas across executions or NULL
+public:
+    /**
+     * @param premises Input premises count
+     * @param target Proof handler target
+     * @param store Store sharing the formulas across executions, left
+     * owned by the caller, or NULL for a store of each execution
+     */
+    ProofHandler(unsigned premises,
+                 ProofTarget target,
+                 FormulaStore* store = NULL);
+
+    virtual int execute(Configuration&) const;
+};
+
+//! Proof search
+
+/**
+ * Search for proofs of the formulas following the premises.
+ */
+class ProofSearcher: public ExecutionTarget
+{
+private:
+    unsigned premises;
+    ///< Input premises count
+public:
+    ProofSearcher(unsigned);
+
+    virtual int execute(Configuration&) const;
+};
+
+//! Request serving
+
+/**
+ * Serve requests of many clients over a Unix domain socket.
+ */
+class RequestServer: public ExecutionTarget
+{
+private:
+    std::string path;
+    ///< Socket file path
 public:
-    ProofHandler(unsigned,
-                 ProofTarget);
+    RequestServer(const std::string&);
 
     virtual int execute(Configuration&) const;
 };
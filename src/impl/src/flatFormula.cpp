@@ -0,0 +1,237 @@
+#include <cstring>
+#include <stack>
+
+#include "flatFormula.hpp"
+
+using namespace std;
+
+//! Pending operator
+
+/**
+ * Operator waiting for its operands while printing.
+ */
+struct PendingOperator
+{
+    char code;
+    ///< Representing character
+
+    unsigned operands;
+    ///< Count of operands not printed yet
+};
+
+unsigned FlatFormula::getArity(char code)
+{
+    switch (code)
+    {
+        case '-':
+            return 1;
+        case '.':
+        case '+':
+        case '>':
+        case '=':
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+FlatFormula::FlatFormula(Formula* formula)
+{
+    stack<Formula*> nodes;
+
+    nodes.push(formula);
+    while (!nodes.empty())
+    {
+        Formula* node = nodes.top();
+        nodes.pop();
+        codes.push_back(node->getCharacter());
+        switch (getArity(node->getCharacter()))
+        {
+            case 1:
+                nodes.push(((Unary*) node)->getOperand());
+                break;
+            case 2:
+                nodes.push(((Binary*) node)->getRight());
+                nodes.push(((Binary*) node)->getLeft());
+                break;
+        }
+    }
+    sizes.resize(codes.size());
+    for (unsigned position = codes.size(); position-- > 0;)
+    {
+        sizes[position] = 1;
+        switch (getArity(codes[position]))
+        {
+            case 2:
+                sizes[position] += sizes[position + 1 + sizes[position + 1]];
+                // Fall through
+            case 1:
+                sizes[position] += sizes[position + 1];
+                break;
+        }
+    }
+}
+
+Formula* FlatFormula::toFormula(FormulaArena& arena) const
+{
+    stack<Formula*> formulas;
+
+    for (unsigned position = codes.size(); position-- > 0;)
+    {
+        Formula* left;
+        Formula* right;
+        switch (getArity(codes[position]))
+        {
+            case 0:
+                formulas.push(new (arena) Trivial(codes[position]));
+                break;
+            case 1:
+                left = formulas.top();
+                formulas.pop();
+                formulas.push(new (arena) Unary(codes[position], left));
+                break;
+            case 2:
+                left = formulas.top();
+                formulas.pop();
+                right = formulas.top();
+                formulas.pop();
+                formulas.push(new (arena) Binary(codes[position], left, right));
+                break;
+        }
+    }
+    return formulas.top();
+}
+
+unsigned FlatFormula::size() const
+{
+    return codes.size();
+}
+
+char FlatFormula::getCode(unsigned position) const
+{
+    return codes[position];
+}
+
+unsigned FlatFormula::getSize(unsigned position) const
+{
+    return sizes[position];
+}
+
+string FlatFormula::printPrefix(Language language) const
+{
+    string result;
+
+    for (char code : codes)
+    {
+        if (getArity(code) == 0)
+        {
+            result += code;
+        } else
+        {
+            result += Formula::getConnective(code, language);
+        }
+    }
+    return result;
+}
+
+string FlatFormula::printInfix(Language language) const
+{
+    string result;
+    stack<PendingOperator> operators;
+
+    for (char code : codes)
+    {
+        switch (getArity(code))
+        {
+            case 0:
+                result += code;
+                while (!operators.empty())
+                {
+                    PendingOperator& pending = operators.top();
+                    pending.operands--;
+                    if (pending.operands == 1)
+                    {
+                        result += Formula::getConnective(pending.code, language);
+                        break;
+                    }
+                    if (getArity(pending.code) == 2)
+                    {
+                        result += ')';
+                    }
+                    operators.pop();
+                }
+                break;
+            case 1:
+                result += Formula::getConnective(code, language);
+                operators.push({code, 1});
+                break;
+            case 2:
+                result += '(';
+                operators.push({code, 2});
+                break;
+        }
+    }
+    return result;
+}
+
+string FlatFormula::printPostfix(Language language) const
+{
+    string result;
+    stack<PendingOperator> operators;
+
+    for (char code : codes)
+    {
+        if (getArity(code) > 0)
+        {
+            operators.push({code, getArity(code)});
+            continue;
+        }
+        result += code;
+        while (!operators.empty() && --operators.top().operands == 0)
+        {
+            result += Formula::getConnective(operators.top().code, language);
+            operators.pop();
+        }
+    }
+    return result;
+}
+
+bool FlatFormula::equals(const FlatFormula& formula) const
+{
+    return codes == formula.codes;
+}
+
+bool FlatFormula::matches(const FlatFormula& formula) const
+{
+    unsigned starts['Z' - 'A' + 1];
+    unsigned lengths['Z' - 'A' + 1] = {0};
+    unsigned position = 0;
+
+    for (char code : codes)
+    {
+        if (getArity(code) > 0)
+        {
+            if (formula.codes[position] != code)
+            {
+                return false;
+            }
+            position++;
+            continue;
+        }
+        unsigned slot = code - 'A';
+        unsigned length = formula.sizes[position];
+        if (lengths[slot] == 0)
+        {
+            starts[slot] = position;
+            lengths[slot] = length;
+        } else if (lengths[slot] != length
+                   || memcmp(&formula.codes[starts[slot]],
+                             &formula.codes[position],
+                             length) != 0)
+        {
+            return false;
+        }
+        position += length;
+    }
+    return true;
+}
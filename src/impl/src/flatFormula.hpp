@@ -0,0 +1,97 @@
+#ifndef FLAT_FORMULA_HPP
+#define	FLAT_FORMULA_HPP
+
+#include <string>
+#include <vector>
+
+#include "formula.hpp"
+#include "formulaArena.hpp"
+
+//! Flat formula
+
+/**
+ * Formula encoded as a contiguous prefix array of one byte codes, which are
+ * the representing characters, together with the sizes of their subtrees.
+ */
+class FlatFormula
+{
+private:
+    std::vector<char> codes;
+    ///< Representing characters in prefix order
+
+    std::vector<unsigned> sizes;
+    ///< Subtree sizes in prefix order
+
+    /**
+     * Returns the operands count of a representing character.
+     * @param code Representing character
+     * @return Count of operands
+     */
+    static unsigned getArity(char code);
+public:
+    FlatFormula(Formula*);
+
+    /**
+     * Converts this formula to an expression tree.
+     * @param arena Arena to allocate the tree in
+     * @return Formula expression tree root node
+     */
+    Formula* toFormula(FormulaArena& arena) const;
+
+    /**
+     * Nodes count getter.
+     * @return Count of nodes of this formula
+     */
+    unsigned size() const;
+
+    /**
+     * Representing character getter.
+     * @param position Node position in prefix order
+     * @return Representing character of given node
+     */
+    char getCode(unsigned position) const;
+
+    /**
+     * Subtree size getter.
+     * @param position Node position in prefix order
+     * @return Count of nodes of the subtree rooted at given node
+     */
+    unsigned getSize(unsigned position) const;
+
+    /**
+     * Returns a textual representation of this formula in prefix syntax.
+     * @param language Language of connectives to use
+     * @return Textual representation of this formula in prefix syntax
+     */
+    std::string printPrefix(Language language) const;
+
+    /**
+     * Returns a textual representation of this formula in infix syntax.
+     * @param language Language of connectives to use
+     * @return Textual representation of this formula in infix syntax
+     */
+    std::string printInfix(Language language) const;
+
+    /**
+     * Returns a textual representation of this formula in postfix syntax.
+     * @param language Language of connectives to use
+     * @return Textual representation of this formula in postfix syntax
+     */
+    std::string printPostfix(Language language) const;
+
+    /**
+     * Verifies whether given formula equals to this one.
+     * @param formula Formula to be compared with this one
+     * @return True if given formula equals to this one
+     */
+    bool equals(const FlatFormula& formula) const;
+
+    /**
+     * Verifies whether given formula matches this one.
+     * @param formula Formula to be matched to this one
+     * @return True if given formula matches this one
+     */
+    bool matches(const FlatFormula& formula) const;
+};
+
+#endif
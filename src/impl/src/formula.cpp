@@ -1,41 +1,29 @@
-#include <iostream>
-#include <stdexcept>
+#include <vector>
 
 #include "formula.hpp"
+#include "statistics.hpp"
 
-map<char, map<Language, string>> Formula::dictionary = {
-    {'-',
-        {
-            {ASCII, "-"},
-            {WORDS, " not "},
-            {LATEX, " \\neg "}
-        }},
-    {'.',
-        {
-            {ASCII, "."},
-            {WORDS, " and "},
-            {LATEX, " \\wedge "}
-        }},
-    {'+',
-        {
-            {ASCII, "+"},
-            {WORDS, " or "},
-            {LATEX, " \\vee "}
-        }},
-    {'>',
-        {
-            {ASCII, ">"},
-            {WORDS, " implies "},
-            {LATEX, " \\Rightarrow "}
-        }},
-    {'=',
-        {
-            {ASCII, "="},
-            {WORDS, " iff "},
-            {LATEX, " \\Leftrightarrow "}
-        }}
+using namespace std;
+
+//! Print step
+
+/**
+ * Formula node waiting to be printed.
+ */
+struct PrintStep
+{
+    const Formula* formula;
+    ///< Node to be printed
+
+    unsigned stage;
+    ///< Count of the node parts printed so far
 };
 
+static thread_local vector<PrintStep> steps;
+///< Print steps stack reused by the printers of each thread
+
+constexpr const char* Formula::connectives[5][3];
+
 Formula::Formula(char character)
 : character(character)
 {
@@ -45,52 +33,225 @@ Formula::~Formula()
 {
 }
 
+void* Formula::operator new(size_t size,
+                            FormulaArena& arena)
+{
+    return arena.allocate(size);
+}
+
+void Formula::operator delete(void* memory)
+{
+}
+
+const char* Formula::getConnective(char character,
+                                   Language language)
+{
+    switch (character)
+    {
+        case '-':
+            return connectives[0][language];
+        case '.':
+            return connectives[1][language];
+        case '+':
+            return connectives[2][language];
+        case '>':
+            return connectives[3][language];
+        default:
+            return connectives[4][language];
+    }
+}
+
 char Formula::getCharacter() const
 {
     return character;
 }
 
-Composite::Composite(char character)
-: Formula(character)
+void Formula::printPrefix(Language language,
+                          string& buffer) const
+{
+    steps.clear();
+    steps.push_back({this, 0});
+    while (!steps.empty())
+    {
+        const Formula* formula = steps.back().formula;
+        steps.pop_back();
+        switch (formula->character)
+        {
+            case '-':
+                buffer += getConnective(formula->character, language);
+                steps.push_back({((const Unary*) formula)->getOperand(), 0});
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                buffer += getConnective(formula->character, language);
+                steps.push_back({((const Binary*) formula)->getRight(), 0});
+                steps.push_back({((const Binary*) formula)->getLeft(), 0});
+                break;
+            default:
+                buffer += formula->character;
+                break;
+        }
+    }
+}
+
+void Formula::printInfix(Language language,
+                         string& buffer) const
 {
+    steps.clear();
+    steps.push_back({this, 0});
+    while (!steps.empty())
+    {
+        PrintStep step = steps.back();
+        steps.pop_back();
+        switch (step.formula->character)
+        {
+            case '-':
+                buffer += getConnective(step.formula->character, language);
+                steps.push_back({((const Unary*) step.formula)->getOperand(), 0});
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                switch (step.stage)
+                {
+                    case 0:
+                        buffer += '(';
+                        steps.push_back({step.formula, 1});
+                        steps.push_back({((const Binary*) step.formula)->getLeft(), 0});
+                        break;
+                    case 1:
+                        buffer += getConnective(step.formula->character, language);
+                        steps.push_back({step.formula, 2});
+                        steps.push_back({((const Binary*) step.formula)->getRight(), 0});
+                        break;
+                    default:
+                        buffer += ')';
+                        break;
+                }
+                break;
+            default:
+                buffer += step.formula->character;
+                break;
+        }
+    }
 }
 
-Trivial::Trivial(char character)
-: Formula(character)
+void Formula::printPostfix(Language language,
+                           string& buffer) const
+{
+    steps.clear();
+    steps.push_back({this, 0});
+    while (!steps.empty())
+    {
+        PrintStep step = steps.back();
+        steps.pop_back();
+        if (step.stage > 0)
+        {
+            buffer += getConnective(step.formula->character, language);
+            continue;
+        }
+        switch (step.formula->character)
+        {
+            case '-':
+                steps.push_back({step.formula, 1});
+                steps.push_back({((const Unary*) step.formula)->getOperand(), 0});
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                steps.push_back({step.formula, 1});
+                steps.push_back({((const Binary*) step.formula)->getRight(), 0});
+                steps.push_back({((const Binary*) step.formula)->getLeft(), 0});
+                break;
+            default:
+                buffer += step.formula->character;
+                break;
+        }
+    }
+}
+
+string Formula::printPrefix(Language language) const
 {
+    string buffer;
+
+    printPrefix(language, buffer);
+    return buffer;
 }
 
-string Trivial::printPrefix(Language language) const
+string Formula::printInfix(Language language) const
 {
-    return string() + this->character;
+    string buffer;
+
+    printInfix(language, buffer);
+    return buffer;
 }
 
-string Trivial::printInfix(Language language) const
+string Formula::printPostfix(Language language) const
 {
-    return string() + this->character;
+    string buffer;
+
+    printPostfix(language, buffer);
+    return buffer;
 }
 
-string Trivial::printPostfix(Language language) const
+size_t Formula::hash() const
 {
-    return string() + this->character;
+    return hashValue;
+}
+
+size_t Formula::combine(size_t seed,
+                        size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+bool Formula::sharedWith(const Formula* formula) const
+{
+    return store != 0 && store == formula->store;
+}
+
+Composite::Composite(char character)
+: Formula(character)
+{
+}
+
+Trivial::Trivial(char character)
+: Formula(character)
+{
+    hashValue = combine(0, character);
 }
 
 bool Trivial::equals(Formula* formula) const
 {
+    Statistics::count(EQUALS_CALLS);
     return this->character == formula->getCharacter();
 }
 
 bool Trivial::matches(Formula* formula,
                       map<char, Formula*>& substitutions) const
 {
-    try
-    {
-        return substitutions.at(character)->equals(formula);
-    } catch (out_of_range& exception)
+    auto substitute = substitutions.emplace(character, formula);
+
+    Statistics::count(MATCHES_CALLS);
+    return substitute.second || substitute.first->second->equals(formula);
+}
+
+bool Trivial::matches(Formula* formula,
+                      Substitution& substitution) const
+{
+    Formula* substitute = substitution.get(character);
+
+    Statistics::count(MATCHES_CALLS);
+    if (substitute == NULL)
     {
-        substitutions.emplace(character, formula);
+        substitution.set(character, formula);
         return true;
     }
+    return substitute->equals(formula);
 }
 
 Binary::Binary(char character)
@@ -98,39 +259,36 @@ Binary::Binary(char character)
 {
 }
 
-Binary::~Binary()
+Binary::Binary(char character,
+               Formula* left,
+               Formula* right)
+: Composite(character), left(left), right(right)
 {
-    delete left;
-    delete right;
+    updateHash();
 }
 
-string Binary::printPrefix(Language language) const
+Formula* Binary::getLeft() const
 {
-    return dictionary.at(character).at(language)
-            + left->printPrefix(language)
-            + right->printPrefix(language);
+    return left;
 }
 
-string Binary::printInfix(Language language) const
+Formula* Binary::getRight() const
 {
-    return string()
-            + '('
-            + left->printInfix(language)
-            + dictionary.at(character).at(language)
-            + right->printInfix(language)
-            + ')';
-}
-
-string Binary::printPostfix(Language language) const
-{
-    return left->printPostfix(language)
-            + right->printPostfix(language)
-            + dictionary.at(character).at(language);
+    return right;
 }
 
 bool Binary::equals(Formula* formula) const
 {
-    return character == formula->getCharacter()
+    Statistics::count(EQUALS_CALLS);
+    if (this == formula)
+    {
+        return true;
+    } else if (sharedWith(formula))
+    {
+        return false;
+    }
+    return hashValue == formula->hash()
+            && character == formula->getCharacter()
             && left->equals(((Binary*) formula)->left)
             && right->equals(((Binary*) formula)->right);
 }
@@ -138,11 +296,26 @@ bool Binary::equals(Formula* formula) const
 bool Binary::matches(Formula* formula,
                      map<char, Formula*>& substitutions) const
 {
+    Statistics::count(MATCHES_CALLS);
     return character == formula->getCharacter()
             && left->matches(((Binary*) formula)->left, substitutions)
             && right->matches(((Binary*) formula)->right, substitutions);
 }
 
+bool Binary::matches(Formula* formula,
+                     Substitution& substitution) const
+{
+    Statistics::count(MATCHES_CALLS);
+    return character == formula->getCharacter()
+            && left->matches(((Binary*) formula)->left, substitution)
+            && right->matches(((Binary*) formula)->right, substitution);
+}
+
+void Binary::updateHash()
+{
+    hashValue = combine(combine(combine(0, character), left->hash()), right->hash());
+}
+
 bool Binary::setFirst(Formula* operand)
 {
     if (left == NULL)
@@ -153,6 +326,7 @@ bool Binary::setFirst(Formula* operand)
     {
         right = operand;
     }
+    updateHash();
     return true;
 }
 
@@ -166,6 +340,7 @@ bool Binary::setLast(Formula* operand)
     {
         left = operand;
     }
+    updateHash();
     return true;
 }
 
@@ -174,40 +349,52 @@ Unary::Unary(char character)
 {
 }
 
-Unary::~Unary()
+Unary::Unary(char character,
+             Formula* operand)
+: Composite(character), operand(operand)
 {
-    delete operand;
+    updateHash();
 }
 
-string Unary::printPrefix(Language language) const
+Formula* Unary::getOperand() const
 {
-    return dictionary.at(character).at(language)
-            + operand->printPrefix(language);
+    return operand;
 }
 
-string Unary::printInfix(Language language) const
+bool Unary::equals(Formula* formula) const
 {
-    return dictionary.at(character).at(language)
-            + operand->printInfix(language);
+    Statistics::count(EQUALS_CALLS);
+    if (this == formula)
+    {
+        return true;
+    } else if (sharedWith(formula))
+    {
+        return false;
+    }
+    return hashValue == formula->hash()
+            && character == formula->getCharacter()
+            && operand->equals(((Unary*) formula)->operand);
 }
 
-string Unary::printPostfix(Language language) const
+bool Unary::matches(Formula* formula,
+                    map<char, Formula*>& subsitutions) const
 {
-    return operand->printPostfix(language)
-            + dictionary.at(character).at(language);
+    Statistics::count(MATCHES_CALLS);
+    return character == formula->getCharacter()
+            && operand->matches(((Unary*) formula)->operand, subsitutions);
 }
 
-bool Unary::equals(Formula* formula) const
+bool Unary::matches(Formula* formula,
+                    Substitution& substitution) const
 {
+    Statistics::count(MATCHES_CALLS);
     return character == formula->getCharacter()
-            && operand->equals(((Unary*) formula)->operand);
+            && operand->matches(((Unary*) formula)->operand, substitution);
 }
 
-bool Unary::matches(Formula* formula,
-                    map<char, Formula*>& subsitutions) const
+void Unary::updateHash()
 {
-    return character == formula->getCharacter()
-            && operand->matches(((Unary*) formula)->operand, subsitutions);
+    hashValue = combine(combine(0, character), operand->hash());
 }
 
 bool Unary::setFirst(Formula* operand)
@@ -216,6 +403,7 @@ bool Unary::setFirst(Formula* operand)
     {
         this->operand = operand;
     }
+    updateHash();
     return true;
 }
 
@@ -225,5 +413,6 @@ bool Unary::setLast(Formula* operand)
     {
         this->operand = operand;
     }
+    updateHash();
     return true;
 }
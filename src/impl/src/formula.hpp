@@ -4,7 +4,8 @@
 #include <map>
 #include <string>
 
-using namespace std;
+#include "formulaArena.hpp"
+#include "substitution.hpp"
 
 //! Output language of connectives
 
@@ -22,45 +23,130 @@ enum Language
 
 /**
  * Formula expression tree node.
+ * Nodes are allocated in a formula arena and never deleted individually.
  */
 class Formula
 {
+    friend class FormulaStore;
 protected:
-    static map<char, map<Language, string>> dictionary;
-    ///< Output connectives dictionary
+    static constexpr const char* connectives[5][3] = {
+        {"-", " not ", " \\neg "},
+        {".", " and ", " \\wedge "},
+        {"+", " or ", " \\vee "},
+        {">", " implies ", " \\Rightarrow "},
+        {"=", " iff ", " \\Leftrightarrow "}
+    };
+    ///< Output connectives by operator and language
 
     char character;
     ///< Representing character
+
+    unsigned store = 0;
+    ///< Identifier of the store sharing this node, zero if not interned
+
+    size_t hashValue = 0;
+    ///< Structural hash value
+
+    /**
+     * Checks whether given formula is interned in the same store as this
+     * one, so that it equals to this one only if it is the same node.
+     * @param formula Formula to be compared with this one
+     * @return True if both formulas are shared by the same store
+     */
+    bool sharedWith(const Formula* formula) const;
+
+    /**
+     * Mixes given value into a hash seed.
+     * @param seed Hash value computed so far
+     * @param value Value to be mixed in
+     * @return Combined hash value
+     */
+    static size_t combine(size_t seed,
+                          size_t value);
 public:
     Formula(char);
     virtual ~Formula();
 
+    /**
+     * Allocates a node in given arena.
+     * @param size Size of the node in bytes
+     * @param arena Arena to allocate the node in
+     * @return Allocated memory
+     */
+    static void* operator new(size_t size,
+                              FormulaArena& arena);
+
+    /**
+     * Releases nothing, the node memory belongs to its arena.
+     * @param memory Memory allocated for the node
+     */
+    static void operator delete(void* memory);
+
+    /**
+     * Returns the textual representation of a connective.
+     * @param character Representing character of the connective
+     * @param language Language of connectives to use
+     * @return Textual representation of the connective
+     */
+    static const char* getConnective(char character,
+                                     Language language);
+
     /**
      * Representing character getter.
      * @return Representing character
      */
     char getCharacter() const;
 
+    /**
+     * Structural hash getter.
+     * @return Hash value, equal for equal formulas
+     */
+    size_t hash() const;
+
+    /**
+     * Appends a textual representation of this formula in prefix syntax.
+     * @param language Language of connectives to use
+     * @param buffer Buffer to append the representation to
+     */
+    void printPrefix(Language language,
+                     std::string& buffer) const;
+
+    /**
+     * Appends a textual representation of this formula in infix syntax.
+     * @param language Language of connectives to use
+     * @param buffer Buffer to append the representation to
+     */
+    void printInfix(Language language,
+                    std::string& buffer) const;
+
+    /**
+     * Appends a textual representation of this formula in postfix syntax.
+     * @param language Language of connectives to use
+     * @param buffer Buffer to append the representation to
+     */
+    void printPostfix(Language language,
+                      std::string& buffer) const;
+
     /**
      * Returns a textual representation of this formula in prefix syntax.
      * @param language Language of connectives to use
      * @return Textual representation of this formula in prefix syntax
      */
-    virtual string printPrefix(Language language) const = 0;
+    std::string printPrefix(Language language) const;
 
     /**
      * Returns a textual representation of this formula in infix syntax.
      * @param language Language of connectives to use
      * @return Textual representation of this formula in infix syntax
      */
-    virtual string printInfix(Language language) const = 0;
+    std::string printInfix(Language language) const;
 
     /**
      * Returns a textual representation of this formula in postfix syntax.
      * @param language Language of connectives to use
      * @return Textual representation of this formula in postfix syntax
      */
-    virtual string printPostfix(Language language) const = 0;
+    std::string printPostfix(Language language) const;
 
     /**
      * Verifies whether given formula equals to this one.
@@ -76,7 +162,16 @@ public:
      * @return True if given formula matches this one
      */
     virtual bool matches(Formula* formula,
-                         map<char, Formula*>& substitutions) const = 0;
+                         std::map<char, Formula*>& substitutions) const = 0;
+
+    /**
+     * Verifies whether given formula matches this one.
+     * @param formula Formula to be matched to this one
+     * @param substitution Propositions substitution of this formula
+     * @return True if given formula matches this one
+     */
+    virtual bool matches(Formula* formula,
+                         Substitution& substitution) const = 0;
 };
 
 //! Composite formula
@@ -113,12 +208,11 @@ class Trivial: public Formula
 {
 public:
     Trivial(char);
-    virtual string printPrefix(Language) const;
-    virtual string printInfix(Language) const;
-    virtual string printPostfix(Language) const;
     virtual bool equals(Formula*) const;
     virtual bool matches(Formula*,
-                         map<char, Formula*>&) const;
+                         std::map<char, Formula*>&) const;
+    virtual bool matches(Formula*,
+                         Substitution&) const;
 };
 
 //! Binary operator compound formula
@@ -134,16 +228,34 @@ private:
 
     Formula* right = NULL;
     ///< The right operand
+
+    /**
+     * Computes the hash value once both operands are set.
+     */
+    void updateHash();
 public:
     Binary(char);
-    virtual ~Binary();
+    Binary(char,
+           Formula*,
+           Formula*);
+
+    /**
+     * Left operand getter.
+     * @return The left operand
+     */
+    Formula* getLeft() const;
+
+    /**
+     * Right operand getter.
+     * @return The right operand
+     */
+    Formula* getRight() const;
 
-    virtual string printPrefix(Language) const;
-    virtual string printInfix(Language) const;
-    virtual string printPostfix(Language) const;
     virtual bool equals(Formula*) const;
     virtual bool matches(Formula*,
-                         map<char, Formula*>&) const;
+                         std::map<char, Formula*>&) const;
+    virtual bool matches(Formula*,
+                         Substitution&) const;
     virtual bool setFirst(Formula*);
     virtual bool setLast(Formula*);
 };
@@ -158,16 +270,27 @@ class Unary: public Composite
 private:
     Formula* operand = NULL;
     ///< The operand
+
+    /**
+     * Computes the hash value once the operand is set.
+     */
+    void updateHash();
 public:
     Unary(char);
-    virtual ~Unary();
+    Unary(char,
+          Formula*);
+
+    /**
+     * Operand getter.
+     * @return The operand
+     */
+    Formula* getOperand() const;
 
-    virtual string printPrefix(Language) const;
-    virtual string printInfix(Language) const;
-    virtual string printPostfix(Language) const;
     virtual bool equals(Formula*) const;
     virtual bool matches(Formula*,
-                         map<char, Formula*>&) const;
+                         std::map<char, Formula*>&) const;
+    virtual bool matches(Formula*,
+                         Substitution&) const;
     virtual bool setFirst(Formula*);
     virtual bool setLast(Formula*);
 };
@@ -0,0 +1,45 @@
+#include "formulaArena.hpp"
+#include "statistics.hpp"
+
+using namespace std;
+
+FormulaArena::FormulaArena()
+{
+}
+
+FormulaArena::~FormulaArena()
+{
+    Statistics::countNodes(nodes);
+    for (char* block : blocks)
+    {
+        delete[] block;
+    }
+}
+
+void* FormulaArena::allocate(size_t size)
+{
+    void* memory;
+
+    size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (offset + size > BLOCK_SIZE)
+    {
+        if (used == blocks.size())
+        {
+            blocks.push_back(new char[BLOCK_SIZE]);
+        }
+        used++;
+        offset = 0;
+    }
+    memory = blocks[used - 1] + offset;
+    offset += size;
+    nodes++;
+    return memory;
+}
+
+void FormulaArena::reset()
+{
+    Statistics::countNodes(nodes);
+    used = 0;
+    offset = BLOCK_SIZE;
+    nodes = 0;
+}
@@ -0,0 +1,52 @@
+#ifndef FORMULA_ARENA_HPP
+#define	FORMULA_ARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+//! Formula arena
+
+/**
+ * Bump allocator owning formula nodes, which are released all at once.
+ */
+class FormulaArena
+{
+private:
+    static const size_t BLOCK_SIZE = 65536;
+    ///< Size of a memory block in bytes
+
+    static const size_t ALIGNMENT = alignof(std::max_align_t);
+    ///< Alignment of allocated nodes
+
+    std::vector<char*> blocks;
+    ///< Memory blocks allocated so far
+
+    size_t used = 0;
+    ///< Count of blocks in use
+
+    size_t offset = BLOCK_SIZE;
+    ///< Offset of the first free byte in the last block in use
+
+    size_t nodes = 0;
+    ///< Count of nodes allocated since the last reset
+public:
+    FormulaArena();
+    FormulaArena(const FormulaArena&) = delete;
+    ~FormulaArena();
+
+    FormulaArena& operator=(const FormulaArena&) = delete;
+
+    /**
+     * Allocates memory for a formula node.
+     * @param size Size of the node in bytes
+     * @return Allocated memory, valid until the next reset
+     */
+    void* allocate(size_t size);
+
+    /**
+     * Releases all nodes at once, keeping the memory blocks for reuse.
+     */
+    void reset();
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include <atomic>
+
+#include "formulaStore.hpp"
+
+using namespace std;
+
+//! Intern step
+
+/**
+ * Pending node of the iterative interning.
+ */
+struct InternStep
+{
+    Formula* formula;
+    ///< Node to be interned
+
+    bool expanded;
+    ///< Whether the operands have been scheduled already
+};
+
+static atomic<unsigned> stores(0);
+///< Count of the stores created so far
+
+static thread_local vector<InternStep> steps;
+///< Intern steps stack reused by the stores of each thread
+
+static thread_local vector<Formula*> operands;
+///< Shared operands stack reused by the stores of each thread
+
+FormulaStore::FormulaStore()
+: identifier(++stores)
+{
+    // Zero marks the nodes not interned anywhere
+    if (identifier == 0)
+    {
+        identifier = ++stores;
+    }
+}
+
+Formula* FormulaStore::find(Formula* formula,
+                            Formula* first,
+                            Formula* last) const
+{
+    auto range = nodes.equal_range(formula->hash());
+
+    for (auto node = range.first; node != range.second; node++)
+    {
+        Formula* candidate = node->second;
+        if (candidate->getCharacter() != formula->getCharacter())
+        {
+            continue;
+        }
+        if (first == NULL
+            || (last == NULL && ((Unary*) candidate)->getOperand() == first)
+            || (last != NULL && ((Binary*) candidate)->getLeft() == first
+                && ((Binary*) candidate)->getRight() == last))
+        {
+            return candidate;
+        }
+    }
+    return NULL;
+}
+
+Formula* FormulaStore::intern(Formula* formula)
+{
+    Formula* shared;
+
+    steps.push_back({formula, false});
+    while (!steps.empty())
+    {
+        InternStep step = steps.back();
+        Formula* first = NULL;
+        Formula* last = NULL;
+
+        steps.pop_back();
+        switch (step.formula->getCharacter())
+        {
+            case '-':
+                if (!step.expanded)
+                {
+                    steps.push_back({step.formula, true});
+                    steps.push_back({((Unary*) step.formula)->getOperand(), false});
+                    continue;
+                }
+                first = operands.back();
+                operands.pop_back();
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                if (!step.expanded)
+                {
+                    steps.push_back({step.formula, true});
+                    steps.push_back({((Binary*) step.formula)->getRight(), false});
+                    steps.push_back({((Binary*) step.formula)->getLeft(), false});
+                    continue;
+                }
+                last = operands.back();
+                operands.pop_back();
+                first = operands.back();
+                operands.pop_back();
+                break;
+        }
+        shared = find(step.formula, first, last);
+        if (shared == NULL)
+        {
+            if (first == NULL)
+            {
+                shared = new (arena) Trivial(step.formula->getCharacter());
+            } else if (last == NULL)
+            {
+                shared = new (arena) Unary(step.formula->getCharacter(), first);
+            } else
+            {
+                shared = new (arena) Binary(step.formula->getCharacter(), first, last);
+            }
+            shared->store = identifier;
+            nodes.emplace(shared->hash(), shared);
+        }
+        operands.push_back(shared);
+    }
+    shared = operands.back();
+    operands.pop_back();
+    return shared;
+}
+
+size_t FormulaStore::size() const
+{
+    return nodes.size();
+}
+
+void FormulaStore::clear()
+{
+    nodes.clear();
+    arena.reset();
+}
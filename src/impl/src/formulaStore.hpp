@@ -0,0 +1,62 @@
+#ifndef FORMULA_STORE_HPP
+#define	FORMULA_STORE_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include "formula.hpp"
+#include "formulaArena.hpp"
+
+//! Formula store
+
+/**
+ * Interning store sharing one immutable node per distinct subformula.
+ */
+class FormulaStore
+{
+private:
+    FormulaArena arena;
+    ///< Arena owning the shared nodes
+
+    std::unordered_multimap<size_t, Formula*> nodes;
+    ///< Shared nodes by structural hash
+
+    unsigned identifier;
+    ///< Identifier marking the shared nodes of this store
+
+    /**
+     * Finds a shared node with given character and operands.
+     * @param formula Formula the node is to be equal to
+     * @param first First shared operand or NULL
+     * @param last Last shared operand or NULL
+     * @return Shared node or NULL when there is none
+     */
+    Formula* find(Formula* formula,
+                  Formula* first,
+                  Formula* last) const;
+public:
+    FormulaStore();
+
+    /**
+     * Returns the shared node equal to given formula, interning its
+     * operands first without recursion.
+     * Two formulas interned in the same store are equal exactly when they
+     * are the same node, which their comparison relies on.
+     * @param formula Formula to be interned, left owned by the caller
+     * @return Shared node owned by this store
+     */
+    Formula* intern(Formula* formula);
+
+    /**
+     * Counts the shared nodes.
+     * @return Count of the shared nodes
+     */
+    size_t size() const;
+
+    /**
+     * Releases all shared nodes, invalidating the formulas interned so far.
+     */
+    void clear();
+};
+
+#endif
@@ -0,0 +1,246 @@
+#include <iostream>
+#include <stdlib.h>
+#include <thread>
+
+#include "configuration.hpp"
+#include "executionTarget.hpp"
+#include "linePipeline.hpp"
+#include "statistics.hpp"
+
+using namespace std;
+
+LinePipeline::LinePipeline(Configuration& config,
+                           const LineTarget& target)
+: config(config), target(target), workers(config.getJobs())
+{
+}
+
+void LinePipeline::read()
+{
+    LineReader& reader = *config.getReader();
+    Line line;
+    unsigned lines = 0;
+
+    while (true)
+    {
+        Batch* batch = new Batch();
+        while (batch->ends.size() < BATCH_SIZE
+               && (batch->ends.empty() || reader.ready())
+               && reader.next(line))
+        {
+            batch->text.append(line.begin, line.end);
+            batch->ends.push_back(batch->text.size());
+            batch->terminated.push_back(line.terminated);
+        }
+        if (batch->ends.empty())
+        {
+            delete batch;
+            break;
+        }
+        batch->paused = !reader.ready();
+        batch->first = lines + 1;
+        lines += batch->ends.size();
+
+        unique_lock<mutex> guard(lock);
+        while (pending >= 2 * workers && !stopped)
+        {
+            changed.wait(guard);
+        }
+        if (stopped)
+        {
+            delete batch;
+            break;
+        }
+        batch->sequence = batches++;
+        pending++;
+        waiting.push(batch);
+        changed.notify_all();
+    }
+
+    lock_guard<mutex> guard(lock);
+    exhausted = true;
+    changed.notify_all();
+}
+
+void LinePipeline::work()
+{
+    FormulaArena arena;
+
+    while (true)
+    {
+        Batch* batch;
+        {
+            unique_lock<mutex> guard(lock);
+            while (waiting.empty() && !exhausted && !stopped)
+            {
+                changed.wait(guard);
+            }
+            if (waiting.empty() || stopped)
+            {
+                return;
+            }
+            batch = waiting.front();
+            waiting.pop();
+        }
+
+        size_t begin = 0;
+        batch->results.resize(batch->ends.size());
+        for (unsigned index = 0; index < batch->ends.size(); index++)
+        {
+            Line line = {
+                batch->text.data() + begin,
+                batch->text.data() + batch->ends[index],
+                batch->terminated[index]
+            };
+            handle(batch->first + index, line, arena, batch->results[index]);
+            begin = batch->ends[index];
+        }
+
+        lock_guard<mutex> guard(lock);
+        finished[batch->sequence] = batch;
+        changed.notify_all();
+    }
+}
+
+void LinePipeline::handle(unsigned number,
+                          const Line& line,
+                          FormulaArena& arena,
+                          LineResult& result) const
+{
+    Statistics::setLine(number);
+    PhaseTimer timer(HANDLING);
+
+    target.process(config, line, arena, result);
+    arena.reset();
+}
+
+bool LinePipeline::write(const LineResult& result)
+{
+    if (result.end)
+    {
+        return false;
+    }
+    output += result.output;
+    if (!result.error.empty())
+    {
+        flush();
+        config.getErrors() << result.error;
+    } else if (output.size() >= OUTPUT_SIZE)
+    {
+        flush();
+    }
+    if (result.failure)
+    {
+        failure = true;
+        return !config.getStrict();
+    }
+    return true;
+}
+
+void LinePipeline::flush()
+{
+    config.getOutput().write(output.data(), output.size());
+    config.getOutput().flush();
+    output.clear();
+}
+
+int LinePipeline::run()
+{
+    // Serial handling
+    if (workers <= 1)
+    {
+        FormulaArena arena;
+        Line line;
+        unsigned number = 0;
+
+        while (true)
+        {
+            if (!config.getReader()->ready())
+            {
+                flush();
+            }
+            if (!config.getReader()->next(line))
+            {
+                break;
+            }
+            LineResult result;
+            handle(++number, line, arena, result);
+            if (!write(result))
+            {
+                break;
+            }
+        }
+        flush();
+        return failure ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    // Parallel handling
+    vector<thread> threads;
+    unsigned sequence = 0;
+    bool running = true;
+
+    threads.emplace_back(&LinePipeline::read, this);
+    for (unsigned worker = 0; worker < workers; worker++)
+    {
+        threads.emplace_back(&LinePipeline::work, this);
+    }
+    while (running)
+    {
+        Batch* batch;
+        {
+            unique_lock<mutex> guard(lock);
+            while (finished.find(sequence) == finished.end()
+                   && !(exhausted && sequence == batches))
+            {
+                changed.wait(guard);
+            }
+            if (finished.find(sequence) == finished.end())
+            {
+                break;
+            }
+            batch = finished[sequence];
+            finished.erase(sequence);
+        }
+        for (const LineResult& result : batch->results)
+        {
+            if (!write(result))
+            {
+                running = false;
+                break;
+            }
+        }
+        if (batch->paused)
+        {
+            flush();
+        }
+        delete batch;
+        sequence++;
+
+        lock_guard<mutex> guard(lock);
+        pending--;
+        changed.notify_all();
+    }
+    flush();
+
+    // Cleanup
+    {
+        lock_guard<mutex> guard(lock);
+        stopped = true;
+        changed.notify_all();
+    }
+    config.getReader()->cancel();
+    for (thread& worker : threads)
+    {
+        worker.join();
+    }
+    while (!waiting.empty())
+    {
+        delete waiting.front();
+        waiting.pop();
+    }
+    for (auto& batch : finished)
+    {
+        delete batch.second;
+    }
+    return failure ? EXIT_FAILURE : EXIT_SUCCESS;
+}
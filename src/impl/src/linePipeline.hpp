@@ -0,0 +1,164 @@
+#ifndef LINE_PIPELINE_HPP
+#define	LINE_PIPELINE_HPP
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "formulaArena.hpp"
+#include "lineReader.hpp"
+
+class Configuration;
+class LineTarget;
+
+//! Line result
+
+/**
+ * Outcome of handling one input line.
+ */
+struct LineResult
+{
+    bool end = false;
+    ///< End of formulas flag
+
+    bool failure = false;
+    ///< Failure flag
+
+    std::string output;
+    ///< Text to be written to the standard output
+
+    std::string error;
+    ///< Text to be written to the error output
+};
+
+//! Line pipeline
+
+/**
+ * Reads input lines in batches, lets a pool of workers handle them and
+ * writes their results in the input order.
+ */
+class LinePipeline
+{
+private:
+    static const unsigned BATCH_SIZE = 1024;
+    ///< Count of lines in a batch
+
+    static const size_t OUTPUT_SIZE = 1 << 20;
+    ///< Size of the standard output buffer in bytes
+
+    //! Batch of lines
+
+    /**
+     * Input lines copied out of the reader together with their results.
+     */
+    struct Batch
+    {
+        unsigned sequence;
+        ///< Position of this batch in the input
+
+        unsigned first;
+        ///< Input number of the first line
+
+        std::string text;
+        ///< Characters of all lines
+
+        std::vector<size_t> ends;
+        ///< Offsets past the last character of each line
+
+        std::vector<bool> terminated;
+        ///< Newline termination flags of each line
+
+        std::vector<LineResult> results;
+        ///< Results of each line
+
+        bool paused;
+        ///< Input not immediately available after this batch flag
+    };
+
+    Configuration& config;
+    ///< Program configuration
+
+    const LineTarget& target;
+    ///< Target handling the lines
+
+    unsigned workers;
+    ///< Count of worker threads
+
+    bool failure = false;
+    ///< Failure written flag
+
+    std::string output;
+    ///< Standard output buffer
+
+    std::mutex lock;
+    ///< Lock guarding the state below
+
+    std::condition_variable changed;
+    ///< Signalled on every state change
+
+    std::queue<Batch*> waiting;
+    ///< Batches read and waiting for a worker
+
+    std::map<unsigned, Batch*> finished;
+    ///< Batches handled and waiting to be written
+
+    unsigned batches = 0;
+    ///< Count of batches read
+
+    unsigned pending = 0;
+    ///< Count of batches read but not written yet
+
+    bool exhausted = false;
+    ///< End of input reached flag
+
+    bool stopped = false;
+    ///< Stop request flag
+
+    /**
+     * Reads input lines into batches.
+     */
+    void read();
+
+    /**
+     * Handles the lines of waiting batches.
+     */
+    void work();
+
+    /**
+     * Handles one input line, timing it and resetting the arena afterwards.
+     * @param number Input number of the line
+     * @param line Input line to be handled
+     * @param arena Arena to allocate formulas in
+     * @param result Result of the line to be filled in
+     */
+    void handle(unsigned number,
+                const Line& line,
+                FormulaArena& arena,
+                LineResult& result) const;
+
+    /**
+     * Writes a line result.
+     * @param result Result to be written
+     * @return False when no further results are to be written
+     */
+    bool write(const LineResult& result);
+
+    /**
+     * Writes out the standard output buffer.
+     */
+    void flush();
+public:
+    LinePipeline(Configuration&,
+                 const LineTarget&);
+
+    /**
+     * Handles all input lines.
+     * @return Program exit status
+     */
+    int run();
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lineReader.hpp"
+
+using namespace std;
+
+LineReader::LineReader(int descriptor)
+: descriptor(descriptor)
+{
+    struct stat status;
+
+    if (fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode)
+        && status.st_size > 0)
+    {
+        mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping != MAP_FAILED)
+        {
+            madvise(mapping, status.st_size, MADV_SEQUENTIAL);
+            mappingSize = status.st_size;
+            data = (const char*) mapping;
+            size = mappingSize;
+            exhausted = true;
+            return;
+        }
+        mapping = NULL;
+    }
+    buffer.resize(BLOCK_SIZE);
+    data = buffer.data();
+    if (pipe(wakeup) != 0)
+    {
+        wakeup[0] = wakeup[1] = -1;
+    }
+}
+
+LineReader::LineReader(const char* data,
+                       size_t size)
+: descriptor(-1), data(data), size(size), exhausted(true)
+{
+}
+
+LineReader::~LineReader()
+{
+    if (mapping != NULL)
+    {
+        munmap(mapping, mappingSize);
+    }
+    if (wakeup[0] >= 0)
+    {
+        close(wakeup[0]);
+        close(wakeup[1]);
+    }
+}
+
+void LineReader::fill()
+{
+    ssize_t count;
+
+    memmove(buffer.data(), buffer.data() + start, size - start);
+    size -= start;
+    start = 0;
+    if (size == buffer.size())
+    {
+        buffer.resize(2 * buffer.size());
+    }
+    data = buffer.data();
+    if (wakeup[0] >= 0)
+    {
+        pollfd events[2] = {
+            {descriptor, POLLIN, 0},
+            {wakeup[0], POLLIN, 0}
+        };
+        while (poll(events, 2, -1) < 0 && errno == EINTR)
+        {
+        }
+        if (events[1].revents != 0)
+        {
+            exhausted = true;
+            return;
+        }
+    }
+    do
+    {
+        count = read(descriptor, buffer.data() + size, buffer.size() - size);
+    } while (count < 0 && errno == EINTR);
+    if (count > 0)
+    {
+        size += count;
+    } else
+    {
+        exhausted = true;
+    }
+}
+
+bool LineReader::next(Line& line)
+{
+    while (true)
+    {
+        const char* newline = (const char*) memchr(data + start, '\n', size - start);
+        if (newline != NULL)
+        {
+            line = {data + start, newline, true};
+            start = newline - data + 1;
+            return true;
+        }
+        if (exhausted)
+        {
+            if (start == size)
+            {
+                return false;
+            }
+            line = {data + start, data + size, false};
+            start = size;
+            return true;
+        }
+        fill();
+    }
+}
+
+bool LineReader::ready() const
+{
+    return exhausted || memchr(data + start, '\n', size - start) != NULL;
+}
+
+void LineReader::cancel()
+{
+    if (wakeup[1] >= 0)
+    {
+        char signal = 0;
+        while (write(wakeup[1], &signal, 1) < 0 && errno == EINTR)
+        {
+        }
+    }
+}
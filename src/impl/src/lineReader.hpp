@@ -0,0 +1,101 @@
+#ifndef LINE_READER_HPP
+#define	LINE_READER_HPP
+
+#include <cstddef>
+#include <vector>
+
+//! Input line
+
+/**
+ * Characters of one input line, the newline excluded.
+ */
+struct Line
+{
+    const char* begin;
+    ///< The first character
+
+    const char* end;
+    ///< Position past the last character
+
+    bool terminated;
+    ///< True if the line ends with a newline
+};
+
+//! Line reader
+
+/**
+ * Reads input lines in large blocks, or maps regular files to memory, and
+ * hands them out without copying.
+ */
+class LineReader
+{
+private:
+    static const size_t BLOCK_SIZE = 1 << 20;
+    ///< Size of a read block in bytes
+
+    int descriptor;
+    ///< File descriptor to read from
+
+    void* mapping = NULL;
+    ///< Memory mapped file or NULL when reading blocks
+
+    size_t mappingSize = 0;
+    ///< Size of the memory mapped file
+
+    std::vector<char> buffer;
+    ///< Read blocks buffer
+
+    const char* data = NULL;
+    ///< Data read so far
+
+    size_t start = 0;
+    ///< Offset of the first unread character
+
+    size_t size = 0;
+    ///< Count of characters read so far
+
+    bool exhausted = false;
+    ///< End of input flag
+
+    int wakeup[2] = {-1, -1};
+    ///< Pipe interrupting blocked reads
+
+    /**
+     * Reads another block, keeping the unread characters.
+     */
+    void fill();
+public:
+    LineReader(int);
+
+    /**
+     * Creates a reader of characters held in memory.
+     * @param data Input characters, valid while being read
+     * @param size Count of input characters
+     */
+    LineReader(const char* data,
+               size_t size);
+    LineReader(const LineReader&) = delete;
+    ~LineReader();
+
+    LineReader& operator=(const LineReader&) = delete;
+
+    /**
+     * Reads the next line.
+     * @param line Line to be set, valid until the next read
+     * @return False at the end of input
+     */
+    bool next(Line& line);
+
+    /**
+     * Verifies whether the next line can be read without blocking.
+     * @return True if the next line is buffered or the input is exhausted
+     */
+    bool ready() const;
+
+    /**
+     * Makes a blocked or later read end the input, from any thread.
+     */
+    void cancel();
+};
+
+#endif
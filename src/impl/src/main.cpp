@@ -1,7 +1,9 @@
+#include <fstream>
 #include <stdlib.h>
 
 #include "configuration.hpp"
 #include "executionTarget.hpp"
+#include "statistics.hpp"
 #include "usageException.hpp"
 
 using namespace std;
@@ -12,7 +14,36 @@ int main(int argc,
     try
     {
         Configuration config(argc, argv);
-        return config.getTarget()->execute(config);
+        int exit = config.getTarget()->execute(config);
+
+        // Statistics report
+        if (Statistics::isEnabled())
+        {
+            if (config.getStatistics().empty())
+            {
+                Statistics::report(cerr);
+            } else
+            {
+                ofstream file(config.getStatistics());
+                Statistics::report(file);
+                if (!file)
+                {
+                    cerr << "Cannot write statistics to " << config.getStatistics() << "." << endl;
+                }
+            }
+        }
+
+        // Trace events
+        if (Statistics::isTracing())
+        {
+            ofstream file(config.getTrace());
+            Statistics::writeTrace(file);
+            if (!file)
+            {
+                cerr << "Cannot write trace to " << config.getTrace() << "." << endl;
+            }
+        }
+        return exit;
     } catch (UsageException& exception)
     {
         cerr << exception.getMessage() << endl;
@@ -1,6 +1,23 @@
 #include <sstream>
 
 #include "parseException.hpp"
+#include "statistics.hpp"
+
+using namespace std;
+
+//! Parse error counters
+
+/**
+ * Statistics counters of the parse error kinds, from the incomplete formula.
+ */
+static const Counter errorCounters[] = {
+    INCOMPLETE_FORMULAS,
+    UNEXPECTED_EOFS,
+    INVALID_ANNOTATIONS,
+    ILLEGAL_CHARACTERS,
+    REDUNDANT_ELEMENTS,
+    UNEXPECTED_ELEMENTS
+};
 
 ParseException::ParseException(string message)
 : message(message)
@@ -37,6 +54,11 @@ UnexpectedEOFException::UnexpectedEOFException()
 {
 }
 
+InvalidAnnotationException::InvalidAnnotationException()
+: ParseException("Invalid annotation")
+{
+}
+
 IllegalCharacterException::IllegalCharacterException(char character,
                                                      unsigned position)
 : DetailedParseException("Illegal character",
@@ -60,3 +82,61 @@ UnexpectedElementException::UnexpectedElementException(char character,
                          position)
 {
 }
+
+ParseError::ParseError(ParseErrorKind kind,
+                       char character,
+                       unsigned position)
+: kind(kind), character(character), position(position)
+{
+    if (failed())
+    {
+        Statistics::count(errorCounters[kind - INCOMPLETE_FORMULA]);
+    }
+}
+
+bool ParseError::failed() const
+{
+    return kind != NO_PARSE_ERROR;
+}
+
+void ParseError::raise() const
+{
+    switch (kind)
+    {
+        case INCOMPLETE_FORMULA:
+            throw IncompleteFormulaException();
+        case UNEXPECTED_EOF:
+            throw UnexpectedEOFException();
+        case INVALID_ANNOTATION:
+            throw InvalidAnnotationException();
+        case ILLEGAL_CHARACTER:
+            throw IllegalCharacterException(character, position);
+        case REDUNDANT_ELEMENT:
+            throw RedundantElementException(character, position);
+        case UNEXPECTED_ELEMENT:
+            throw UnexpectedElementException(character, position);
+        default:
+            throw ParseException("No parse error");
+    }
+}
+
+string ParseError::getMessage() const
+{
+    switch (kind)
+    {
+        case INCOMPLETE_FORMULA:
+            return IncompleteFormulaException().getMessage();
+        case UNEXPECTED_EOF:
+            return UnexpectedEOFException().getMessage();
+        case INVALID_ANNOTATION:
+            return InvalidAnnotationException().getMessage();
+        case ILLEGAL_CHARACTER:
+            return IllegalCharacterException(character, position).getMessage();
+        case REDUNDANT_ELEMENT:
+            return RedundantElementException(character, position).getMessage();
+        case UNEXPECTED_ELEMENT:
+            return UnexpectedElementException(character, position).getMessage();
+        default:
+            return ParseException("No parse error").getMessage();
+    }
+}
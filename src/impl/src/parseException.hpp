@@ -3,8 +3,6 @@
 
 #include <string>
 
-using namespace std;
-
 //! Formula parse exception
 
 /**
@@ -13,16 +11,16 @@ using namespace std;
 class ParseException
 {
 protected:
-    string message;
+    std::string message;
     ///< Exception details
 public:
-    ParseException(string);
+    ParseException(std::string);
 
     /**
      * Composes an error message.
      * @return Parse error message
      */
-    virtual string getMessage() const;
+    virtual std::string getMessage() const;
 };
 
 //! Detailed parse exception
@@ -39,10 +37,10 @@ protected:
     unsigned position;
     ///< Erroneous character position
 public:
-    DetailedParseException(string,
+    DetailedParseException(std::string,
                            char,
                            unsigned);
-    virtual string getMessage() const;
+    virtual std::string getMessage() const;
 };
 
 //! Incomplete formula exception
@@ -67,6 +65,17 @@ public:
     UnexpectedEOFException();
 };
 
+//! Invalid annotation exception
+
+/**
+ * Thrown when a proof line annotation is malformed.
+ */
+class InvalidAnnotationException: public ParseException
+{
+public:
+    InvalidAnnotationException();
+};
+
 //! Illegal character exception
 
 /**
@@ -103,4 +112,67 @@ public:
                                unsigned);
 };
 
+//! Parse error kind
+
+/**
+ * Kinds of parse failures, one for each parse exception.
+ */
+enum ParseErrorKind
+{
+    NO_PARSE_ERROR, ///< No failure
+    INCOMPLETE_FORMULA, ///< Incomplete formula
+    UNEXPECTED_EOF, ///< Unexpected end of stream
+    INVALID_ANNOTATION, ///< Invalid annotation
+    ILLEGAL_CHARACTER, ///< Illegal character
+    REDUNDANT_ELEMENT, ///< Redundant element
+    UNEXPECTED_ELEMENT ///< Unexpected element
+};
+
+//! Parse error
+
+/**
+ * Parse failure reported without throwing. The matching exception is built
+ * only when the failure is raised or its message is needed.
+ */
+struct ParseError
+{
+    ParseErrorKind kind = NO_PARSE_ERROR;
+    ///< Failure kind
+
+    char character = 0;
+    ///< Erroneous character of the detailed kinds
+
+    unsigned position = 0;
+    ///< Erroneous character position of the detailed kinds
+
+    ParseError() = default;
+
+    /**
+     * Records a parse failure, counting it in the statistics.
+     * @param kind Failure kind
+     * @param character Erroneous character of the detailed kinds
+     * @param position Erroneous character position of the detailed kinds
+     */
+    ParseError(ParseErrorKind kind,
+               char character = 0,
+               unsigned position = 0);
+
+    /**
+     * Verifies whether a failure was recorded.
+     * @return True if parsing failed
+     */
+    bool failed() const;
+
+    /**
+     * Throws the exception matching the recorded failure.
+     */
+    [[noreturn]] void raise() const;
+
+    /**
+     * Composes the message of the exception matching the recorded failure.
+     * @return Parse error message
+     */
+    std::string getMessage() const;
+};
+
 #endif
@@ -1,11 +1,15 @@
+#include <array>
+#include <cstdint>
 #include <cstdio>
-#include <limits>
-#include <sstream>
 #include <stack>
+#include <string>
+#include <vector>
 
 #include "parseException.hpp"
 #include "parseFormula.hpp"
 
+using namespace std;
+
 //! Bracket state
 
 /**
@@ -20,16 +24,258 @@ enum BracketState
     LAST_OPERAND ///< Last operand set
 };
 
-Formula* parsePrefix(istream& input)
+//! Character class
+
+/**
+ * Class of an input character for the validation fast paths.
+ */
+enum CharacterClass
+{
+    LETTER, ///< Proposition
+    NEGATION, ///< Unary operator
+    CONNECTIVE, ///< Binary operator
+    OPENING, ///< Opening bracket
+    CLOSING, ///< Closing bracket
+    SPACE, ///< Space or tabulator
+    OTHER ///< Any other character
+};
+
+static const unsigned INFIX_DEPTH = 64;
+///< Bracket nesting depth the infix fast path can track, one bit each
+
+static const size_t PREFIX_NEEDS[] = {1, 1, 1, SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX};
+///< Pending operands each character class needs in prefix, spaces being
+///< left to the exact validation
+
+static const size_t PREFIX_CHANGES[] = {(size_t) -1, 0, 1, 0, 0, 0, 0};
+///< Pending operands change by each character class in prefix
+
+static const size_t POSTFIX_NEEDS[] = {0, 1, 2, SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX};
+///< Complete operands each character class needs in postfix, spaces being
+///< left to the exact validation
+
+static const size_t POSTFIX_CHANGES[] = {1, 0, (size_t) -1, 0, 0, 0, 0};
+///< Complete operands change by each character class in postfix
+
+static const unsigned char INFIX_REJECTS[][OTHER + 1] = {
+    {1, 1, 0, 1, 0, 1, 1},
+    {0, 0, 1, 0, 1, 1, 1},
+    {0, 0, 1, 0, 1, 1, 1},
+    {0, 0, 1, 0, 1, 1, 1},
+    {1, 1, 0, 1, 0, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1}
+};
+///< Character classes left to the exact validation after each class in
+///< infix, spaces included
+
+//! Classify characters
+
+/**
+ * Creates the table of character classes.
+ * @return Class of each character value
+ */
+static array<unsigned char, 256> classify()
+{
+    array<unsigned char, 256> classes;
+
+    classes.fill(OTHER);
+    for (char letter = 'A'; letter <= 'Z'; letter++)
+    {
+        classes[(unsigned char) letter] = LETTER;
+    }
+    classes['-'] = NEGATION;
+    classes['.'] = CONNECTIVE;
+    classes['+'] = CONNECTIVE;
+    classes['>'] = CONNECTIVE;
+    classes['='] = CONNECTIVE;
+    classes['('] = OPENING;
+    classes[')'] = CLOSING;
+    classes[' '] = SPACE;
+    classes['\t'] = SPACE;
+    return classes;
+}
+
+static const array<unsigned char, 256> characterClasses = classify();
+///< Class of each character value
+
+//! Infix validation words
+
+/**
+ * Bracket stack words of the infix validation of each thread, kept
+ * allocated.
+ */
+static thread_local vector<uint64_t> bracketWords;
+
+//! Bracket stack
+
+/**
+ * Bracket states of the exact infix validation packed four bits per open
+ * bracket into reused words. The unary operators above a bracket are all
+ * removed together, so each run of them is kept as one flag.
+ */
+class BracketStack
+{
+private:
+    static const unsigned NEGATED = 8;
+    ///< Flag of the unary operators set above a bracket
+
+    vector<uint64_t>& words;
+    ///< Storage of the bracket states, sixteen in each word
+
+    size_t depth;
+    ///< Count of the open brackets
+
+    bool negated;
+    ///< Whether unary operators are set outside of any bracket
+
+    /**
+     * Returns the state bits of the innermost bracket.
+     * @return State of the bracket with its unary flag
+     */
+    unsigned get() const
+    {
+        return (words[(depth - 1) / 16] >> (depth - 1) % 16 * 4) & 0xF;
+    }
+
+    /**
+     * Stores the state bits of the innermost bracket.
+     * @param bits State of the bracket with its unary flag
+     */
+    void set(unsigned bits)
+    {
+        uint64_t& word = words[(depth - 1) / 16];
+        unsigned shift = (depth - 1) % 16 * 4;
+
+        word = (word & ~((uint64_t) 0xF << shift)) | (uint64_t) bits << shift;
+    }
+public:
+    /**
+     * @param words Storage of the bracket states to reuse
+     */
+    BracketStack(vector<uint64_t>& words)
+    : words(words), depth(0), negated(false)
+    {
+    }
+
+    /**
+     * Checks whether no bracket is open and no unary operator is pending.
+     * @return True if the stack is empty, false otherwise
+     */
+    bool empty() const
+    {
+        return depth == 0 && !negated;
+    }
+
+    /**
+     * Returns the top state, the stack not being empty.
+     * @return Unary if unary operators are pending, the state of the
+     * innermost bracket otherwise
+     */
+    BracketState top() const
+    {
+        if (depth == 0 || get() & NEGATED)
+        {
+            return UNARY;
+        } else
+        {
+            return (BracketState) get();
+        }
+    }
+
+    /**
+     * Sets a unary operator on the top.
+     */
+    void pushUnary()
+    {
+        if (depth == 0)
+        {
+            negated = true;
+        } else
+        {
+            set(get() | NEGATED);
+        }
+    }
+
+    /**
+     * Opens a new bracket.
+     */
+    void pushBracket()
+    {
+        depth++;
+        if (words.size() * 16 < depth)
+        {
+            words.push_back(0);
+        }
+        set(BLANK);
+    }
+
+    /**
+     * Replaces the state of the innermost bracket, no unary operator being
+     * pending.
+     * @param state New state of the bracket
+     */
+    void replace(BracketState state)
+    {
+        set(state);
+    }
+
+    /**
+     * Completes an operand, removing the pending unary operators and
+     * advancing the innermost bracket.
+     */
+    void complete()
+    {
+        if (depth == 0)
+        {
+            negated = false;
+        } else
+        {
+            set((get() & ~NEGATED) + 1);
+        }
+    }
+
+    /**
+     * Closes the innermost bracket, completing the operand it forms.
+     */
+    void close()
+    {
+        depth--;
+        complete();
+    }
+};
+
+//! Read line
+
+/**
+ * Reads a line from a stream.
+ * @param input Input stream to read from
+ * @param text Storage for the line characters
+ * @return Line stored in given storage
+ */
+static Line readLine(istream& input,
+                     string& text)
+{
+    getline(input, text);
+    return
+    {
+        text.data(), text.data() + text.size(), !input.eof()
+    };
+}
+
+Formula* parsePrefix(const Line& line,
+                     FormulaArena& arena,
+                     ParseError& error)
 {
     bool run = true;
+    const char* next = line.begin;
     unsigned position = 1;
     Formula* temporary = NULL;
     stack<Composite*> operators;
 
     while (run)
     {
-        char buffer = input.get();
+        char buffer = next < line.end ? *next++ : line.terminated ? '\n' : EOF;
         switch (buffer)
         {
             case 'A':
@@ -60,7 +306,7 @@ Formula* parsePrefix(istream& input)
             case 'Z':
                 if (!operators.empty())
                 {
-                    temporary = new Trivial(buffer);
+                    temporary = new (arena) Trivial(buffer);
                     while (!operators.empty()
                            && operators.top()->setFirst(temporary))
                     {
@@ -69,23 +315,21 @@ Formula* parsePrefix(istream& input)
                     }
                 } else if (position == 1)
                 {
-                    temporary = new Trivial(buffer);
+                    temporary = new (arena) Trivial(buffer);
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    delete temporary;
-                    throw RedundantElementException(buffer, position);
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case '-':
                 if (!operators.empty() || position == 1)
                 {
-                    operators.push(new Unary(buffer));
+                    operators.push(new (arena) Unary(buffer));
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    delete temporary;
-                    throw RedundantElementException(buffer, position);
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case '.':
@@ -94,12 +338,11 @@ Formula* parsePrefix(istream& input)
             case '=':
                 if (!operators.empty() || position == 1)
                 {
-                    operators.push(new Binary(buffer));
+                    operators.push(new (arena) Binary(buffer));
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    delete temporary;
-                    throw RedundantElementException(buffer, position);
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case ' ':
@@ -115,35 +358,13 @@ Formula* parsePrefix(istream& input)
                     run = false;
                 } else
                 {
-                    if (operators.empty())
-                    {
-                        delete temporary;
-                    } else
-                    {
-                        while (!operators.empty())
-                        {
-                            delete operators.top();
-                            operators.pop();
-                        }
-                    }
-                    throw UnexpectedEOFException();
+                    error = ParseError(UNEXPECTED_EOF);
+                    return NULL;
                 }
                 break;
             default:
-                input.ignore(numeric_limits<streamsize>::max(), '\n');
-                if (operators.empty())
-                {
-                    delete temporary;
-                } else
-                {
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                }
-                throw IllegalCharacterException(buffer, position);
-                break;
+                error = ParseError(ILLEGAL_CHARACTER, buffer, position);
+                return NULL;
         }
         position++;
     }
@@ -152,18 +373,17 @@ Formula* parsePrefix(istream& input)
         return temporary;
     } else
     {
-        while (!operators.empty())
-        {
-            delete operators.top();
-            operators.pop();
-        }
-        throw IncompleteFormulaException();
+        error = ParseError(INCOMPLETE_FORMULA);
+        return NULL;
     }
 }
 
-Formula* parseInfix(istream& input)
+Formula* parseInfix(const Line& line,
+                    FormulaArena& arena,
+                    ParseError& error)
 {
     bool run = true;
+    const char* next = line.begin;
     unsigned position = 1;
     Formula* temporary;
     stack<Formula*> formulas;
@@ -172,7 +392,7 @@ Formula* parseInfix(istream& input)
 
     while (run)
     {
-        char buffer = input.get();
+        char buffer = next < line.end ? *next++ : line.terminated ? '\n' : EOF;
         switch (buffer)
         {
             case 'A':
@@ -205,29 +425,19 @@ Formula* parseInfix(istream& input)
                 {
                     if (position == 1)
                     {
-                        formulas.push(new Trivial(buffer));
+                        formulas.push(new (arena) Trivial(buffer));
                     } else
                     {
-                        input.ignore(numeric_limits<streamsize>::max(), '\n');
-                        while (!formulas.empty())
-                        {
-                            delete formulas.top();
-                            formulas.pop();
-                        }
-                        while (!operators.empty())
-                        {
-                            delete operators.top();
-                            operators.pop();
-                        }
-                        throw UnexpectedElementException(buffer, position);
+                        error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                        return NULL;
                     }
                 } else if (states.top() == BLANK || states.top() == BINARY)
                 {
-                    formulas.push(new Trivial(buffer));
+                    formulas.push(new (arena) Trivial(buffer));
                     states.top()++;
                 } else if (states.top() == UNARY)
                 {
-                    temporary = new Trivial(buffer);
+                    temporary = new (arena) Trivial(buffer);
                     do
                     {
                         operators.top()->setFirst(temporary);
@@ -242,56 +452,26 @@ Formula* parseInfix(istream& input)
                     }
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                    throw UnexpectedElementException(buffer, position);
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case '-':
                 if (states.empty() && position != 1)
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                    throw RedundantElementException(buffer, position);
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return NULL;
                 } else if ((states.empty() && position == 1)
                            || states.top() == BLANK
                            || states.top() == BINARY
                            || states.top() == UNARY)
                 {
                     states.push(UNARY);
-                    operators.push(new Unary(buffer));
+                    operators.push(new (arena) Unary(buffer));
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                    throw UnexpectedElementException(buffer, position);
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case '.':
@@ -300,52 +480,23 @@ Formula* parseInfix(istream& input)
             case '=':
                 if (states.empty())
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
                     if (position == 1)
                     {
-                        while (!formulas.empty())
-                        {
-                            delete formulas.top();
-                            formulas.pop();
-                        }
-                        while (!operators.empty())
-                        {
-                            delete operators.top();
-                            operators.pop();
-                        }
-                        throw UnexpectedElementException(buffer, position);
+                        error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                        return NULL;
                     } else
                     {
-                        while (!formulas.empty())
-                        {
-                            delete formulas.top();
-                            formulas.pop();
-                        }
-                        while (!operators.empty())
-                        {
-                            delete operators.top();
-                            operators.pop();
-                        }
-                        throw RedundantElementException(buffer, position);
+                        error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                        return NULL;
                     }
                 } else if (states.top() == FIRST_OPERAND)
                 {
                     states.top() = BINARY;
-                    operators.push(new Binary(buffer));
+                    operators.push(new (arena) Binary(buffer));
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                    throw UnexpectedElementException(buffer, position);
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case '(':
@@ -356,18 +507,8 @@ Formula* parseInfix(istream& input)
                         states.push(BLANK);
                     } else
                     {
-                        input.ignore(numeric_limits<streamsize>::max(), '\n');
-                        while (!formulas.empty())
-                        {
-                            delete formulas.top();
-                            formulas.pop();
-                        }
-                        while (!operators.empty())
-                        {
-                            delete operators.top();
-                            operators.pop();
-                        }
-                        throw RedundantElementException(buffer, position);
+                        error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                        return NULL;
                     }
                 } else if (states.top() == BLANK
                            || states.top() == BINARY
@@ -376,35 +517,15 @@ Formula* parseInfix(istream& input)
                     states.push(BLANK);
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                    throw UnexpectedElementException(buffer, position);
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case ')':
                 if (states.empty())
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                    throw RedundantElementException(buffer, position);
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return NULL;
                 } else if (states.top() == LAST_OPERAND)
                 {
                     states.pop();
@@ -429,18 +550,8 @@ Formula* parseInfix(istream& input)
                     }
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                    throw UnexpectedElementException(buffer, position);
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case ' ':
@@ -456,33 +567,13 @@ Formula* parseInfix(istream& input)
                     run = false;
                 } else
                 {
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    while (!operators.empty())
-                    {
-                        delete operators.top();
-                        operators.pop();
-                    }
-                    throw UnexpectedEOFException();
+                    error = ParseError(UNEXPECTED_EOF);
+                    return NULL;
                 }
                 break;
             default:
-                input.ignore(numeric_limits<streamsize>::max(), '\n');
-                while (!formulas.empty())
-                {
-                    delete formulas.top();
-                    formulas.pop();
-                }
-                while (!operators.empty())
-                {
-                    delete operators.top();
-                    operators.pop();
-                }
-                throw IllegalCharacterException(buffer, position);
-                break;
+                error = ParseError(ILLEGAL_CHARACTER, buffer, position);
+                return NULL;
         }
         position++;
     }
@@ -497,30 +588,24 @@ Formula* parseInfix(istream& input)
         }
     } else
     {
-        while (!formulas.empty())
-        {
-            delete formulas.top();
-            formulas.pop();
-        }
-        while (!operators.empty())
-        {
-            delete operators.top();
-            operators.pop();
-        }
-        throw IncompleteFormulaException();
+        error = ParseError(INCOMPLETE_FORMULA);
+        return NULL;
     }
 }
 
-Formula* parsePostfix(istream& input)
+Formula* parsePostfix(const Line& line,
+                      FormulaArena& arena,
+                      ParseError& error)
 {
     bool run = true;
+    const char* next = line.begin;
     unsigned position = 1;
     Composite* temporary;
     stack<Formula*> formulas;
 
     while (run)
     {
-        char buffer = input.get();
+        char buffer = next < line.end ? *next++ : line.terminated ? '\n' : EOF;
         switch (buffer)
         {
             case 'A':
@@ -549,24 +634,19 @@ Formula* parsePostfix(istream& input)
             case 'X':
             case 'Y':
             case 'Z':
-                formulas.push(new Trivial(buffer));
+                formulas.push(new (arena) Trivial(buffer));
                 break;
             case '-':
                 if (!formulas.empty())
                 {
-                    temporary = new Unary(buffer);
+                    temporary = new (arena) Unary(buffer);
                     temporary->setLast(formulas.top());
                     formulas.pop();
                     formulas.push(temporary);
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    throw RedundantElementException(buffer, position);
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case '.':
@@ -575,7 +655,7 @@ Formula* parsePostfix(istream& input)
             case '=':
                 if (formulas.size() > 1)
                 {
-                    temporary = new Binary(buffer);
+                    temporary = new (arena) Binary(buffer);
                     temporary->setLast(formulas.top());
                     formulas.pop();
                     temporary->setLast(formulas.top());
@@ -583,13 +663,8 @@ Formula* parsePostfix(istream& input)
                     formulas.push(temporary);
                 } else
                 {
-                    input.ignore(numeric_limits<streamsize>::max(), '\n');
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    throw RedundantElementException(buffer, position);
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return NULL;
                 }
                 break;
             case ' ':
@@ -605,23 +680,13 @@ Formula* parsePostfix(istream& input)
                     run = false;
                 } else
                 {
-                    while (!formulas.empty())
-                    {
-                        delete formulas.top();
-                        formulas.pop();
-                    }
-                    throw UnexpectedEOFException();
+                    error = ParseError(UNEXPECTED_EOF);
+                    return NULL;
                 }
                 break;
             default:
-                input.ignore(numeric_limits<streamsize>::max(), '\n');
-                while (!formulas.empty())
-                {
-                    delete formulas.top();
-                    formulas.pop();
-                }
-                throw IllegalCharacterException(buffer, position);
-                break;
+                error = ParseError(ILLEGAL_CHARACTER, buffer, position);
+                return NULL;
         }
         position++;
     }
@@ -633,11 +698,553 @@ Formula* parsePostfix(istream& input)
         return formulas.top();
     } else
     {
-        while (!formulas.empty())
+        error = ParseError(INCOMPLETE_FORMULA);
+        return NULL;
+    }
+}
+
+//! Check formula in prefix
+
+/**
+ * Validates a line character by character like the prefix parser does,
+ * reporting the same parse failures.
+ * @param line Input line to validate
+ * @param error Storage for the parse failure
+ * @return True if the line holds a formula, false if it is empty or on
+ * failure
+ */
+static bool checkPrefix(const Line& line,
+                        ParseError& error)
+{
+    bool run = true;
+    const char* next = line.begin;
+    unsigned position = 1;
+    size_t operands = 1;
+
+    while (run)
+    {
+        char buffer = next < line.end ? *next++ : line.terminated ? '\n' : EOF;
+        switch (buffer)
         {
-            delete formulas.top();
-            formulas.pop();
+            case 'A':
+            case 'B':
+            case 'C':
+            case 'D':
+            case 'E':
+            case 'F':
+            case 'G':
+            case 'H':
+            case 'I':
+            case 'J':
+            case 'K':
+            case 'L':
+            case 'M':
+            case 'N':
+            case 'O':
+            case 'P':
+            case 'Q':
+            case 'R':
+            case 'S':
+            case 'T':
+            case 'U':
+            case 'V':
+            case 'W':
+            case 'X':
+            case 'Y':
+            case 'Z':
+                if (operands > 0)
+                {
+                    operands--;
+                } else
+                {
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case '-':
+                if (operands == 0)
+                {
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                if (operands > 0)
+                {
+                    operands++;
+                } else
+                {
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case ' ':
+            case '\t':
+                position--;
+                break;
+            case '\n':
+                run = false;
+                break;
+            case EOF:
+                if (position == 1)
+                {
+                    run = false;
+                } else
+                {
+                    error = ParseError(UNEXPECTED_EOF);
+                    return false;
+                }
+                break;
+            default:
+                error = ParseError(ILLEGAL_CHARACTER, buffer, position);
+                return false;
         }
-        throw IncompleteFormulaException();
+        position++;
+    }
+    if (position == 2)
+    {
+        return false;
+    } else if (operands == 0)
+    {
+        return true;
+    } else
+    {
+        error = ParseError(INCOMPLETE_FORMULA);
+        return false;
     }
 }
+
+//! Check formula in infix
+
+/**
+ * Validates a line character by character like the infix parser does,
+ * reporting the same parse failures.
+ * @param line Input line to validate
+ * @param error Storage for the parse failure
+ * @return True if the line holds a formula, false if it is empty or on
+ * failure
+ */
+static bool checkInfix(const Line& line,
+                       ParseError& error)
+{
+    bool run = true;
+    const char* next = line.begin;
+    unsigned position = 1;
+    BracketStack states(bracketWords);
+
+    while (run)
+    {
+        char buffer = next < line.end ? *next++ : line.terminated ? '\n' : EOF;
+        switch (buffer)
+        {
+            case 'A':
+            case 'B':
+            case 'C':
+            case 'D':
+            case 'E':
+            case 'F':
+            case 'G':
+            case 'H':
+            case 'I':
+            case 'J':
+            case 'K':
+            case 'L':
+            case 'M':
+            case 'N':
+            case 'O':
+            case 'P':
+            case 'Q':
+            case 'R':
+            case 'S':
+            case 'T':
+            case 'U':
+            case 'V':
+            case 'W':
+            case 'X':
+            case 'Y':
+            case 'Z':
+                if (states.empty())
+                {
+                    if (position != 1)
+                    {
+                        error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                        return false;
+                    }
+                } else if (states.top() == BLANK
+                           || states.top() == BINARY
+                           || states.top() == UNARY)
+                {
+                    states.complete();
+                } else
+                {
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case '-':
+                if (states.empty() && position != 1)
+                {
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return false;
+                } else if ((states.empty() && position == 1)
+                           || states.top() == BLANK
+                           || states.top() == BINARY
+                           || states.top() == UNARY)
+                {
+                    states.pushUnary();
+                } else
+                {
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                if (states.empty())
+                {
+                    if (position == 1)
+                    {
+                        error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                        return false;
+                    } else
+                    {
+                        error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                        return false;
+                    }
+                } else if (states.top() == FIRST_OPERAND)
+                {
+                    states.replace(BINARY);
+                } else
+                {
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case '(':
+                if (states.empty())
+                {
+                    if (position == 1)
+                    {
+                        states.pushBracket();
+                    } else
+                    {
+                        error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                        return false;
+                    }
+                } else if (states.top() == BLANK
+                           || states.top() == BINARY
+                           || states.top() == UNARY)
+                {
+                    states.pushBracket();
+                } else
+                {
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case ')':
+                if (states.empty())
+                {
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return false;
+                } else if (states.top() == LAST_OPERAND)
+                {
+                    states.close();
+                } else
+                {
+                    error = ParseError(UNEXPECTED_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case ' ':
+            case '\t':
+                position--;
+                break;
+            case '\n':
+                run = false;
+                break;
+            case EOF:
+                if (position == 1)
+                {
+                    run = false;
+                } else
+                {
+                    error = ParseError(UNEXPECTED_EOF);
+                    return false;
+                }
+                break;
+            default:
+                error = ParseError(ILLEGAL_CHARACTER, buffer, position);
+                return false;
+        }
+        position++;
+    }
+    if (states.empty())
+    {
+        return position != 2;
+    } else
+    {
+        error = ParseError(INCOMPLETE_FORMULA);
+        return false;
+    }
+}
+
+//! Check formula in postfix
+
+/**
+ * Validates a line character by character like the postfix parser does,
+ * reporting the same parse failures.
+ * @param line Input line to validate
+ * @param error Storage for the parse failure
+ * @return True if the line holds a formula, false if it is empty or on
+ * failure
+ */
+static bool checkPostfix(const Line& line,
+                         ParseError& error)
+{
+    bool run = true;
+    const char* next = line.begin;
+    unsigned position = 1;
+    size_t formulas = 0;
+
+    while (run)
+    {
+        char buffer = next < line.end ? *next++ : line.terminated ? '\n' : EOF;
+        switch (buffer)
+        {
+            case 'A':
+            case 'B':
+            case 'C':
+            case 'D':
+            case 'E':
+            case 'F':
+            case 'G':
+            case 'H':
+            case 'I':
+            case 'J':
+            case 'K':
+            case 'L':
+            case 'M':
+            case 'N':
+            case 'O':
+            case 'P':
+            case 'Q':
+            case 'R':
+            case 'S':
+            case 'T':
+            case 'U':
+            case 'V':
+            case 'W':
+            case 'X':
+            case 'Y':
+            case 'Z':
+                formulas++;
+                break;
+            case '-':
+                if (formulas == 0)
+                {
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                if (formulas > 1)
+                {
+                    formulas--;
+                } else
+                {
+                    error = ParseError(REDUNDANT_ELEMENT, buffer, position);
+                    return false;
+                }
+                break;
+            case ' ':
+            case '\t':
+                position--;
+                break;
+            case '\n':
+                run = false;
+                break;
+            case EOF:
+                if (position == 1)
+                {
+                    run = false;
+                } else
+                {
+                    error = ParseError(UNEXPECTED_EOF);
+                    return false;
+                }
+                break;
+            default:
+                error = ParseError(ILLEGAL_CHARACTER, buffer, position);
+                return false;
+        }
+        position++;
+    }
+    if (formulas == 0)
+    {
+        return false;
+    } else if (formulas == 1)
+    {
+        return true;
+    } else
+    {
+        error = ParseError(INCOMPLETE_FORMULA);
+        return false;
+    }
+}
+
+bool validatePrefix(const Line& line,
+                    ParseError& error)
+{
+    size_t operands = 1;
+
+    if (line.terminated)
+    {
+        for (const char* next = line.begin; next < line.end; next++)
+        {
+            unsigned char type = characterClasses[(unsigned char) *next];
+            if (operands < PREFIX_NEEDS[type])
+            {
+                return checkPrefix(line, error);
+            }
+            operands += PREFIX_CHANGES[type];
+        }
+        if (operands == 0)
+        {
+            return true;
+        }
+    }
+    return checkPrefix(line, error);
+}
+
+bool validateInfix(const Line& line,
+                   ParseError& error)
+{
+    unsigned char previous = OPENING;
+    unsigned depth = 0;
+    uint64_t connected = 0;
+    unsigned failed = 0;
+
+    if (line.terminated)
+    {
+        // Each character must be allowed after the previous one, and each
+        // bracket must hold one binary operator at its level, marked by its
+        // bit, so that the checks need no branches
+        for (const char* next = line.begin; next < line.end; next++)
+        {
+            unsigned char type = characterClasses[(unsigned char) *next];
+            unsigned open = type == OPENING;
+            unsigned close = type == CLOSING;
+            uint64_t connective = type == CONNECTIVE;
+            failed |= INFIX_REJECTS[previous][type];
+            depth += open;
+            unsigned shift = depth % INFIX_DEPTH;
+            uint64_t marked = connected >> shift & 1;
+            failed |= (connective & (marked | (depth == 0))) | (close & !marked);
+            connected = (connected | connective << shift) & ~((uint64_t) (open | close) << shift);
+            depth -= close;
+            failed |= depth >= INFIX_DEPTH;
+            previous = type;
+        }
+        if (!failed && depth == 0 && (previous == LETTER || previous == CLOSING))
+        {
+            return true;
+        }
+    }
+    return checkInfix(line, error);
+}
+
+bool validatePostfix(const Line& line,
+                     ParseError& error)
+{
+    size_t operands = 0;
+
+    if (line.terminated)
+    {
+        for (const char* next = line.begin; next < line.end; next++)
+        {
+            unsigned char type = characterClasses[(unsigned char) *next];
+            if (operands < POSTFIX_NEEDS[type])
+            {
+                return checkPostfix(line, error);
+            }
+            operands += POSTFIX_CHANGES[type];
+        }
+        if (operands == 1)
+        {
+            return true;
+        }
+    }
+    return checkPostfix(line, error);
+}
+
+Formula* parsePrefix(const Line& line,
+                     FormulaArena& arena)
+{
+    ParseError error;
+    Formula* formula = parsePrefix(line, arena, error);
+
+    if (error.failed())
+    {
+        error.raise();
+    }
+    return formula;
+}
+
+Formula* parsePrefix(istream& input,
+                     FormulaArena& arena)
+{
+    string text;
+
+    return parsePrefix(readLine(input, text), arena);
+}
+
+Formula* parseInfix(const Line& line,
+                    FormulaArena& arena)
+{
+    ParseError error;
+    Formula* formula = parseInfix(line, arena, error);
+
+    if (error.failed())
+    {
+        error.raise();
+    }
+    return formula;
+}
+
+Formula* parseInfix(istream& input,
+                    FormulaArena& arena)
+{
+    string text;
+
+    return parseInfix(readLine(input, text), arena);
+}
+
+Formula* parsePostfix(const Line& line,
+                      FormulaArena& arena)
+{
+    ParseError error;
+    Formula* formula = parsePostfix(line, arena, error);
+
+    if (error.failed())
+    {
+        error.raise();
+    }
+    return formula;
+}
+
+Formula* parsePostfix(istream& input,
+                      FormulaArena& arena)
+{
+    string text;
+
+    return parsePostfix(readLine(input, text), arena);
+}
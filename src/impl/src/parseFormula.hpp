@@ -4,34 +4,143 @@
 #include <istream>
 
 #include "formula.hpp"
-
-using namespace std;
+#include "formulaArena.hpp"
+#include "lineReader.hpp"
+#include "parseException.hpp"
 
 //! Parse formula in prefix
 
+/**
+ * Parses a formula in prefix syntax without throwing.
+ * @param line Input line to parse
+ * @param arena Arena to allocate the formula in
+ * @param error Storage for the parse failure
+ * @return Formula expression tree root node, NULL if the line is empty or
+ * on failure
+ */
+Formula* parsePrefix(const Line& line,
+                     FormulaArena& arena,
+                     ParseError& error);
+
 /**
  * Parses a formula in prefix syntax.
+ * @param line Input line to parse
+ * @param arena Arena to allocate the formula in
+ * @return Formula expression tree root node
+ */
+Formula* parsePrefix(const Line& line,
+                     FormulaArena& arena);
+
+/**
+ * Parses a formula in prefix syntax from a line of a stream.
  * @param input Input stream to read from
+ * @param arena Arena to allocate the formula in
  * @return Formula expression tree root node
  */
-Formula* parsePrefix(istream& input);
+Formula* parsePrefix(std::istream& input,
+                     FormulaArena& arena);
 
 //! Parse formula in infix
 
+/**
+ * Parses a formula in infix syntax without throwing.
+ * @param line Input line to parse
+ * @param arena Arena to allocate the formula in
+ * @param error Storage for the parse failure
+ * @return Formula expression tree root node, NULL if the line is empty or
+ * on failure
+ */
+Formula* parseInfix(const Line& line,
+                    FormulaArena& arena,
+                    ParseError& error);
+
 /**
  * Parses a formula in infix syntax.
+ * @param line Input line to parse
+ * @param arena Arena to allocate the formula in
+ * @return Formula expression tree root node
+ */
+Formula* parseInfix(const Line& line,
+                    FormulaArena& arena);
+
+/**
+ * Parses a formula in infix syntax from a line of a stream.
  * @param input Input stream to read from
+ * @param arena Arena to allocate the formula in
  * @return Formula expression tree root node
  */
-Formula* parseInfix(istream& input);
+Formula* parseInfix(std::istream& input,
+                    FormulaArena& arena);
 
 //! Parse formula in postfix
 
+/**
+ * Parses a formula in postfix syntax without throwing.
+ * @param line Input line to parse
+ * @param arena Arena to allocate the formula in
+ * @param error Storage for the parse failure
+ * @return Formula expression tree root node, NULL if the line is empty or
+ * on failure
+ */
+Formula* parsePostfix(const Line& line,
+                      FormulaArena& arena,
+                      ParseError& error);
+
 /**
  * Parses a formula in postfix syntax.
+ * @param line Input line to parse
+ * @param arena Arena to allocate the formula in
+ * @return Formula expression tree root node
+ */
+Formula* parsePostfix(const Line& line,
+                      FormulaArena& arena);
+
+/**
+ * Parses a formula in postfix syntax from a line of a stream.
  * @param input Input stream to read from
+ * @param arena Arena to allocate the formula in
  * @return Formula expression tree root node
  */
-Formula* parsePostfix(istream& input);
+Formula* parsePostfix(std::istream& input,
+                      FormulaArena& arena);
+
+//! Validate formula in prefix
+
+/**
+ * Verifies that a line holds a formula in prefix syntax without building
+ * its expression tree or throwing.
+ * @param line Input line to validate
+ * @param error Storage for the parse failure
+ * @return True if the line holds a formula, false if it is empty or on
+ * failure
+ */
+bool validatePrefix(const Line& line,
+                    ParseError& error);
+
+//! Validate formula in infix
+
+/**
+ * Verifies that a line holds a formula in infix syntax without building
+ * its expression tree or throwing.
+ * @param line Input line to validate
+ * @param error Storage for the parse failure
+ * @return True if the line holds a formula, false if it is empty or on
+ * failure
+ */
+bool validateInfix(const Line& line,
+                   ParseError& error);
+
+//! Validate formula in postfix
+
+/**
+ * Verifies that a line holds a formula in postfix syntax without building
+ * its expression tree or throwing.
+ * @param line Input line to validate
+ * @param error Storage for the parse failure
+ * @return True if the line holds a formula, false if it is empty or on
+ * failure
+ */
+bool validatePostfix(const Line& line,
+                     ParseError& error);
 
 #endif
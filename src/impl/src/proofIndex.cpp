@@ -0,0 +1,58 @@
+#include "proofIndex.hpp"
+
+using namespace std;
+
+ProofIndex::ProofIndex(const vector<ProofMember*>& proof)
+: proof(proof)
+{
+}
+
+void ProofIndex::update()
+{
+    while (indexed < proof.size())
+    {
+        Formula* formula = proof[indexed]->getFormula();
+        indexed++;
+        members[formula->hash()].push_back(indexed);
+        if (formula->getCharacter() == '>')
+        {
+            implications[((Binary*) formula)->getRight()->hash()].push_back(indexed);
+        }
+    }
+}
+
+unsigned ProofIndex::findMember(Formula* formula) const
+{
+    auto bucket = members.find(formula->hash());
+
+    if (bucket != members.end())
+    {
+        for (unsigned index : bucket->second)
+        {
+            if (proof[index - 1]->getFormula()->equals(formula))
+            {
+                return index;
+            }
+        }
+    }
+    return 0;
+}
+
+list<unsigned> ProofIndex::findImplications(Formula* formula) const
+{
+    list<unsigned> indexes;
+    auto bucket = implications.find(formula->hash());
+
+    if (bucket != implications.end())
+    {
+        for (unsigned index : bucket->second)
+        {
+            Binary* implication = (Binary*) proof[index - 1]->getFormula();
+            if (implication->getRight()->equals(formula))
+            {
+                indexes.push_back(index);
+            }
+        }
+    }
+    return indexes;
+}
@@ -0,0 +1,53 @@
+#ifndef PROOF_INDEX_HPP
+#define	PROOF_INDEX_HPP
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "formula.hpp"
+#include "proofMember.hpp"
+
+//! Proof index
+
+/**
+ * Hash index of proof members kept alongside a proof.
+ */
+class ProofIndex
+{
+private:
+    const std::vector<ProofMember*>& proof;
+    ///< Indexed proof
+
+    unsigned indexed = 0;
+    ///< Count of proof members indexed so far
+
+    std::unordered_map<size_t, std::vector<unsigned>> members;
+    ///< Proof members indexes by formula hash
+
+    std::unordered_map<size_t, std::vector<unsigned>> implications;
+    ///< Implications indexes by consequent hash
+public:
+    ProofIndex(const std::vector<ProofMember*>&);
+
+    /**
+     * Indexes proof members appended since the last update.
+     */
+    void update();
+
+    /**
+     * Finds the first proof member equal to given formula.
+     * @param formula Formula to be found
+     * @return Proof member index or 0 when there is none
+     */
+    unsigned findMember(Formula* formula) const;
+
+    /**
+     * Finds the implications having given formula as their consequent.
+     * @param formula Consequent to be found
+     * @return Implications indexes in ascending order
+     */
+    std::list<unsigned> findImplications(Formula* formula) const;
+};
+
+#endif
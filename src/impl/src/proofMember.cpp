@@ -1,19 +1,28 @@
 #include "proofMember.hpp"
 
+using namespace std;
+
 ProofMember::ProofMember(Formula* formula,
+                         Justification justification,
+                         unsigned type,
                          list<ProofMember*> witnesses)
-: formula(formula), witnesses(witnesses)
+: formula(formula), justification(justification), type(type), witnesses(witnesses)
 {
 }
 
-ProofMember::~ProofMember()
+Formula* ProofMember::getFormula() const
 {
-    delete formula;
+    return formula;
 }
 
-Formula* ProofMember::getFormula() const
+Justification ProofMember::getJustification() const
 {
-    return formula;
+    return justification;
+}
+
+unsigned ProofMember::getType() const
+{
+    return type;
 }
 
 const list<ProofMember*>& ProofMember::getWitnesses() const
@@ -21,6 +30,11 @@ const list<ProofMember*>& ProofMember::getWitnesses() const
     return witnesses;
 }
 
+void ProofMember::setWitnesses(const list<ProofMember*>& witnesses)
+{
+    this->witnesses = witnesses;
+}
+
 bool ProofMember::getPreserve() const
 {
     return preserve;
@@ -3,10 +3,9 @@
 
 #include <list>
 
+#include "annotation.hpp"
 #include "formula.hpp"
 
-using namespace std;
-
 //! Proof member
 
 /**
@@ -16,17 +15,24 @@ class ProofMember
 {
 private:
     Formula* formula;
-    ///< Formula representing this proof member
+    ///< Formula representing this proof member, not owned
+
+    Justification justification;
+    ///< Way this proof member is justified
+
+    unsigned type;
+    ///< Axiom or premise type justifying this proof member
 
-    list<ProofMember*> witnesses;
+    std::list<ProofMember*> witnesses;
     ///< Formulas deducing this one
 
     bool preserve = false;
     ///< Minimal proof component flag
 public:
     ProofMember(Formula*,
-                list<ProofMember*> = list<ProofMember*>());
-    ~ProofMember();
+                Justification,
+                unsigned = 0,
+                std::list<ProofMember*> = std::list<ProofMember*>());
 
     /**
      * Formula getter.
@@ -34,11 +40,29 @@ public:
      */
     Formula* getFormula() const;
 
+    /**
+     * Justification getter.
+     * @return Way this proof member is justified
+     */
+    Justification getJustification() const;
+
+    /**
+     * Type getter.
+     * @return Axiom or premise type justifying this proof member
+     */
+    unsigned getType() const;
+
     /**
      * Witnesses getter.
      * @return Witnesses of this formula
      */
-    const list<ProofMember*>& getWitnesses() const;
+    const std::list<ProofMember*>& getWitnesses() const;
+
+    /**
+     * Witnesses setter.
+     * @param witnesses Witnesses of this formula to be set
+     */
+    void setWitnesses(const std::list<ProofMember*>& witnesses);
 
     /**
      * Minimal proof component flag getter.
@@ -0,0 +1,570 @@
+#include <algorithm>
+
+#include "configuration.hpp"
+#include "proofSearch.hpp"
+
+using namespace std;
+
+ProofSearch::ProofSearch(const ProofSystem& system,
+                         unsigned threads,
+                         unsigned depthLimit,
+                         unsigned sizeLimit,
+                         unsigned lemmaLimit)
+: system(system), threads(max(threads, 1u)),
+  depthLimit(depthLimit), sizeLimit(sizeLimit), lemmaLimit(lemmaLimit),
+  ranges(this->threads), found(this->threads)
+{
+}
+
+ProofSearch::ProofSearch(const Configuration& config)
+: ProofSearch(*config.getSystem(), config.getJobs(),
+              config.getDepthLimit(), config.getSizeLimit(), config.getLemmaLimit())
+{
+}
+
+ProofSearch::~ProofSearch()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopped = true;
+        changed.notify_all();
+    }
+    for (thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ProofSearch::prepareSchema(Formula* formula,
+                                Schema& schema)
+{
+    vector<char>::iterator proposition;
+
+    switch (formula->getCharacter())
+    {
+        case '-':
+            schema.connectives++;
+            prepareSchema(((Unary*) formula)->getOperand(), schema);
+            break;
+        case '.':
+        case '+':
+        case '>':
+        case '=':
+            schema.connectives++;
+            prepareSchema(((Binary*) formula)->getLeft(), schema);
+            prepareSchema(((Binary*) formula)->getRight(), schema);
+            break;
+        default:
+            proposition = find(schema.propositions.begin(), schema.propositions.end(), formula->getCharacter());
+            if (proposition == schema.propositions.end())
+            {
+                schema.propositions.push_back(formula->getCharacter());
+                schema.occurrences.push_back(1);
+            } else
+            {
+                schema.occurrences[proposition - schema.propositions.begin()]++;
+            }
+            break;
+    }
+}
+
+unsigned ProofSearch::addMember(Formula* formula)
+{
+    unsigned size = 1;
+    auto member = sizes.find(formula);
+
+    if (member != sizes.end())
+    {
+        return member->second;
+    }
+    switch (formula->getCharacter())
+    {
+        case '-':
+            size += addMember(((Unary*) formula)->getOperand());
+            break;
+        case '.':
+        case '+':
+        case '>':
+        case '=':
+            size += addMember(((Binary*) formula)->getLeft());
+            size += addMember(((Binary*) formula)->getRight());
+            break;
+    }
+    sizes.emplace(formula, size);
+    universe.push_back(formula);
+    return size;
+}
+
+unsigned ProofSearch::addLemma(const Lemma& lemma)
+{
+    auto derived = known.find(lemma.formula);
+
+    if (derived != known.end())
+    {
+        return derived->second;
+    }
+    if (lemmas.size() >= lemmaLimit)
+    {
+        return NIL;
+    }
+    known.emplace(lemma.formula, lemmas.size());
+    if (lemma.formula->getCharacter() == '>')
+    {
+        implications[((Binary*) lemma.formula)->getLeft()].push_back(lemmas.size());
+    }
+    frontier.push_back(lemmas.size());
+    lemmas.push_back(lemma);
+    return lemmas.size() - 1;
+}
+
+unsigned ProofSearch::addAxiom(Formula* antecedent,
+                               Formula* consequent)
+{
+    Formula* formula = imply(antecedent, consequent);
+    unsigned type = system.isAxiom(formula);
+
+    if (type == 0)
+    {
+        return NIL;
+    }
+    return addLemma({formula, AXIOM, type, NIL, NIL, 0});
+}
+
+unsigned ProofSearch::addDeduction(unsigned implies,
+                                   unsigned implication)
+{
+    if (implies == NIL || implication == NIL)
+    {
+        return NIL;
+    }
+    return addLemma({((Binary*) lemmas[implication].formula)->getRight(), MODUS_PONENS, 0, implies, implication,
+                     max(lemmas[implies].depth, lemmas[implication].depth) + 1});
+}
+
+Formula* ProofSearch::imply(Formula* antecedent,
+                            Formula* consequent)
+{
+    Formula* implication = store.intern(new (scratch) Binary('>', antecedent, consequent));
+
+    scratch.reset();
+    return implication;
+}
+
+void ProofSearch::instantiate()
+{
+    const vector<Formula*>& axioms = system.getAxioms();
+
+    // Members by node count, the earlier first among the equal ones
+    ordered.resize(universe.size());
+    for (unsigned member = 0; member < universe.size(); member++)
+    {
+        ordered[member] = member;
+    }
+    stable_sort(ordered.begin(), ordered.end(),
+                [this](unsigned first, unsigned second)
+                {
+                    return sizes.at(universe[first]) < sizes.at(universe[second]);
+                });
+
+    for (unsigned type = 1; type <= axioms.size(); type++)
+    {
+        Schema schema = {axioms[type - 1], type, {}, {}, {}, 0};
+        Substitution substitution;
+
+        prepareSchema(schema.formula, schema);
+        schema.remaining.resize(schema.propositions.size() + 1, 0);
+        for (unsigned position = schema.propositions.size(); position > 0; position--)
+        {
+            schema.remaining[position - 1] = schema.remaining[position] + schema.occurrences[position - 1];
+        }
+        if (!enumerate(schema, 0, schema.connectives + schema.remaining[0], false, substitution))
+        {
+            break;
+        }
+    }
+    instantiated = universe.size();
+}
+
+bool ProofSearch::enumerate(const Schema& schema,
+                            unsigned position,
+                            unsigned size,
+                            bool fresh,
+                            Substitution& substitution)
+{
+    // Tuples of the universe members, at least one of them new
+    if (position == schema.propositions.size())
+    {
+        if (fresh)
+        {
+            Formula* instance = store.intern(substitute(schema.formula, substitution));
+            scratch.reset();
+            addLemma({instance, AXIOM, schema.type, NIL, NIL, 0});
+        }
+        return lemmas.size() < lemmaLimit;
+    }
+    for (unsigned member : ordered)
+    {
+        // Members are bound in place of a single node counted in the size
+        unsigned bound = size + schema.occurrences[position] * (sizes.at(universe[member]) - 1);
+        if (bound > sizeLimit)
+        {
+            break;
+        }
+        substitution.set(schema.propositions[position], universe[member]);
+        if (!enumerate(schema, position + 1, bound, fresh || member >= instantiated, substitution))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProofSearch::grow()
+{
+    vector<Formula*> relevant;
+
+    // Implications (X>(Y>...(Z>G))) with Y to Z derived, X becoming a goal
+    for (const Lemma& lemma : lemmas)
+    {
+        Formula* formula = lemma.formula;
+        if (formula->getCharacter() != '>' || sizes.count(formula) > 0)
+        {
+            continue;
+        }
+        Formula* consequent = ((Binary*) formula)->getRight();
+        while (goals.count(consequent) == 0 && consequent->getCharacter() == '>'
+               && known.count(((Binary*) consequent)->getLeft()) > 0)
+        {
+            consequent = ((Binary*) consequent)->getRight();
+        }
+        if (goals.count(consequent) > 0 && ((Binary*) formula)->getLeft() != consequent)
+        {
+            relevant.push_back(formula);
+        }
+    }
+    for (Formula* formula : relevant)
+    {
+        addMember(formula);
+        goals.insert(((Binary*) formula)->getLeft());
+    }
+    return !relevant.empty();
+}
+
+Formula* ProofSearch::substitute(Formula* schema,
+                                 const Substitution& substitution)
+{
+    switch (schema->getCharacter())
+    {
+        case '-':
+            return new (scratch) Unary(schema->getCharacter(),
+                                       substitute(((Unary*) schema)->getOperand(), substitution));
+        case '.':
+        case '+':
+        case '>':
+        case '=':
+            return new (scratch) Binary(schema->getCharacter(),
+                                        substitute(((Binary*) schema)->getLeft(), substitution),
+                                        substitute(((Binary*) schema)->getRight(), substitution));
+        default:
+            return substitution.get(schema->getCharacter());
+    }
+}
+
+void ProofSearch::deduce(unsigned lemma,
+                         vector<Deduction>& deductions) const
+{
+    Formula* formula = lemmas[lemma].formula;
+    auto consequents = implications.find(formula);
+
+    // Frontier lemma as the antecedent
+    if (consequents != implications.end())
+    {
+        for (unsigned implication : consequents->second)
+        {
+            if (known.count(((Binary*) lemmas[implication].formula)->getRight()) == 0)
+            {
+                deductions.push_back({implication, lemma});
+            }
+        }
+    }
+
+    // Frontier lemma as the implication
+    if (formula->getCharacter() == '>'
+        && known.count(((Binary*) formula)->getRight()) == 0)
+    {
+        auto implies = known.find(((Binary*) formula)->getLeft());
+        if (implies != known.end())
+        {
+            deductions.push_back({lemma, implies->second});
+        }
+    }
+}
+
+void ProofSearch::deduceChunks(unsigned thread)
+{
+    vector<Deduction>& deductions = found[thread];
+
+    for (unsigned offset = 0; offset < threads; offset++)
+    {
+        Range& range = ranges[(thread + offset) % threads];
+        size_t first;
+
+        while ((first = range.next.fetch_add(CHUNK_SIZE)) < range.end)
+        {
+            for (size_t position = first; position < min(first + CHUNK_SIZE, range.end); position++)
+            {
+                deduce(current[position], deductions);
+            }
+        }
+    }
+}
+
+void ProofSearch::work(unsigned thread)
+{
+    unsigned seen = 0;
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> guard(lock);
+            while (round == seen && !stopped)
+            {
+                changed.wait(guard);
+            }
+            if (stopped)
+            {
+                return;
+            }
+            seen = round;
+        }
+
+        deduceChunks(thread);
+
+        lock_guard<mutex> guard(lock);
+        if (--active == 0)
+        {
+            changed.notify_all();
+        }
+    }
+}
+
+void ProofSearch::saturate(Formula* goal)
+{
+    while (!frontier.empty() && known.count(goal) == 0)
+    {
+        vector<Deduction> deductions;
+        unsigned parts;
+
+        // Modus ponens applications found in parallel, lemmas left unchanged
+        current.clear();
+        current.swap(frontier);
+        parts = current.size() <= CHUNK_SIZE ? 1 : threads;
+        for (unsigned thread = 0; thread < threads; thread++)
+        {
+            ranges[thread].next = min(current.size() * thread / parts, current.size());
+            ranges[thread].end = min(current.size() * (thread + 1) / parts, current.size());
+            found[thread].clear();
+        }
+        if (parts == 1)
+        {
+            deduceChunks(0);
+        } else
+        {
+            unique_lock<mutex> guard(lock);
+            while (workers.size() + 1 < threads)
+            {
+                workers.emplace_back(&ProofSearch::work, this, workers.size() + 1);
+            }
+            round++;
+            active = threads - 1;
+            changed.notify_all();
+            guard.unlock();
+
+            deduceChunks(0);
+
+            guard.lock();
+            while (active > 0)
+            {
+                changed.wait(guard);
+            }
+        }
+
+        // Deterministic merge, the oldest witnesses first
+        for (vector<Deduction>& part : found)
+        {
+            deductions.insert(deductions.end(), part.begin(), part.end());
+        }
+        sort(deductions.begin(), deductions.end(),
+             [](const Deduction& first, const Deduction& second)
+             {
+                 return first.implication < second.implication
+                     || (first.implication == second.implication && first.implies < second.implies);
+             });
+        for (const Deduction& deduction : deductions)
+        {
+            unsigned depth = max(lemmas[deduction.implication].depth, lemmas[deduction.implies].depth) + 1;
+            if (depth <= depthLimit)
+            {
+                addLemma({((Binary*) lemmas[deduction.implication].formula)->getRight(),
+                          MODUS_PONENS, 0, deduction.implies, deduction.implication, depth});
+            }
+        }
+    }
+}
+
+unsigned ProofSearch::derive(Formula* goal)
+{
+    unsigned type = system.isAxiom(goal);
+
+    if (known.count(goal) > 0)
+    {
+        return known.at(goal);
+    } else if (type > 0)
+    {
+        return addLemma({goal, AXIOM, type, NIL, NIL, 0});
+    }
+
+    // Saturation over the subformulas, then the hypothesis of an
+    // implication, then saturation over the growing universe
+    addMember(goal);
+    goals.insert(goal);
+    instantiate();
+    saturate(goal);
+    if (known.count(goal) == 0 && goal->getCharacter() == '>')
+    {
+        unsigned discharged = discharge(goal);
+        if (discharged != NIL)
+        {
+            return discharged;
+        }
+    }
+    for (unsigned growth = 0; growth < depthLimit && known.count(goal) == 0 && lemmas.size() < lemmaLimit; growth++)
+    {
+        if (!grow())
+        {
+            break;
+        }
+        instantiate();
+        saturate(goal);
+    }
+    return known.count(goal) > 0 ? known.at(goal) : NIL;
+}
+
+unsigned ProofSearch::discharge(Formula* goal)
+{
+    ProofSearch hypothetical(system, threads, depthLimit, sizeLimit, lemmaLimit);
+    Formula* hypothesis = ((Binary*) goal)->getLeft();
+    Formula* reflexive = imply(hypothesis, hypothesis);
+    unordered_map<unsigned, unsigned> discharged;
+    unsigned lemma = NIL;
+
+    // Consequent proved with the antecedent as the last premise
+    for (Formula* premise : assumptions)
+    {
+        hypothetical.addPremise(premise);
+    }
+    hypothetical.addPremise(hypothesis);
+    unsigned derived = hypothetical.derive(hypothetical.store.intern(((Binary*) goal)->getRight()));
+    if (derived == NIL)
+    {
+        return NIL;
+    }
+
+    // Each lemma X turned into (H>X) in the derivation order
+    for (unsigned used : hypothetical.collect(derived))
+    {
+        const Lemma& member = hypothetical.lemmas[used];
+        Formula* formula = store.intern(member.formula);
+        if (formula == hypothesis)
+        {
+            // (H>H) from (H>((H>H)>H)), (H>(H>H)) and the second axiom
+            Formula* unfolding = imply(reflexive, hypothesis);
+            unsigned unfolded = addAxiom(hypothesis, unfolding);
+            unsigned weakened = addAxiom(hypothesis, reflexive);
+            unsigned distributed = addAxiom(imply(hypothesis, unfolding),
+                                            imply(imply(hypothesis, reflexive), reflexive));
+            lemma = addDeduction(weakened, addDeduction(unfolded, distributed));
+        } else if (member.justification == MODUS_PONENS)
+        {
+            // (H>Y) from (H>X), (H>(X>Y)) and the second axiom
+            unsigned implies = discharged.at(member.implies);
+            unsigned implication = discharged.at(member.implication);
+            unsigned distributed = addAxiom(lemmas[implication].formula,
+                                            imply(lemmas[implies].formula, imply(hypothesis, formula)));
+            lemma = addDeduction(implies, addDeduction(implication, distributed));
+        } else
+        {
+            // (H>X) from X and the first axiom
+            unsigned justified = addLemma({formula, member.justification, member.type, NIL, NIL, 0});
+            lemma = addDeduction(justified, addAxiom(formula, imply(hypothesis, formula)));
+        }
+        if (lemma == NIL)
+        {
+            return NIL;
+        }
+        discharged.emplace(used, lemma);
+    }
+    return lemma;
+}
+
+vector<unsigned> ProofSearch::collect(unsigned lemma) const
+{
+    vector<unsigned> pending(1, lemma);
+    vector<unsigned> used;
+    unordered_set<unsigned> visited;
+
+    // Witnesses traversal visiting each lemma once
+    while (!pending.empty())
+    {
+        lemma = pending.back();
+        pending.pop_back();
+        if (!visited.insert(lemma).second)
+        {
+            continue;
+        }
+        used.push_back(lemma);
+        if (lemmas[lemma].justification == MODUS_PONENS)
+        {
+            pending.push_back(lemmas[lemma].implies);
+            pending.push_back(lemmas[lemma].implication);
+        }
+    }
+    sort(used.begin(), used.end());
+    return used;
+}
+
+void ProofSearch::addPremise(Formula* formula)
+{
+    Formula* premise = store.intern(formula);
+
+    addMember(premise);
+    assumptions.push_back(premise);
+    addLemma({premise, PREMISE, (unsigned) assumptions.size(), NIL, NIL, 0});
+}
+
+vector<ProofMember*> ProofSearch::prove(Formula* formula)
+{
+    unsigned derived = derive(store.intern(formula));
+    vector<ProofMember*> proof;
+    unordered_map<unsigned, ProofMember*> members;
+
+    if (derived == NIL)
+    {
+        return proof;
+    }
+
+    // Proof members in the derivation order
+    for (unsigned lemma : collect(derived))
+    {
+        const Lemma& member = lemmas[lemma];
+        list<ProofMember*> witnesses;
+        if (member.justification == MODUS_PONENS)
+        {
+            witnesses.push_back(members.at(member.implies));
+            witnesses.push_back(members.at(member.implication));
+        }
+        proof.push_back(new ProofMember(member.formula, member.justification, member.type, witnesses));
+        members[lemma] = proof.back();
+    }
+    return proof;
+}
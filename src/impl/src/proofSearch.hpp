@@ -0,0 +1,376 @@
+#ifndef PROOF_SEARCH_HPP
+#define	PROOF_SEARCH_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "annotation.hpp"
+#include "formula.hpp"
+#include "formulaArena.hpp"
+#include "formulaStore.hpp"
+#include "proofMember.hpp"
+#include "proofSystem.hpp"
+#include "substitution.hpp"
+
+class Configuration;
+
+//! Proof search
+
+/**
+ * Forward saturation of the premises and the axioms instantiated with the
+ * subformulas of the premises and the goals, closed under modus ponens.
+ * When saturation fails, the universe grows with the implications deriving
+ * the goals, their antecedents becoming goals, and the axioms are
+ * instantiated again. An implication still not derived is proved from its
+ * antecedent as an additional premise, the hypothesis discharged through
+ * the deduction theorem. The derived lemmas are kept across the goals.
+ */
+class ProofSearch
+{
+private:
+    static const unsigned NIL = ~0u;
+    ///< Missing lemma
+
+    static const unsigned CHUNK_SIZE = 64;
+    ///< Count of frontier lemmas a thread takes at once
+
+    //! Schema
+
+    /**
+     * Axiom schema prepared for the instantiation.
+     */
+    struct Schema
+    {
+        Formula* formula;
+        ///< Schema formula
+
+        unsigned type;
+        ///< Axiom type
+
+        std::vector<char> propositions;
+        ///< Distinct propositions in the order of appearance
+
+        std::vector<unsigned> occurrences;
+        ///< Occurrence counts of the propositions
+
+        std::vector<unsigned> remaining;
+        ///< Occurrence counts of the propositions from each one on
+
+        unsigned connectives;
+        ///< Count of connective nodes
+    };
+
+    //! Range
+
+    /**
+     * Part of the frontier assigned to a thread, which other threads steal
+     * chunks from once their own is exhausted.
+     */
+    struct Range
+    {
+        std::atomic<size_t> next;
+        ///< Position of the next chunk to be taken
+
+        size_t end;
+        ///< Position past the last lemma
+    };
+
+    //! Lemma
+
+    /**
+     * Derived formula with its justification.
+     */
+    struct Lemma
+    {
+        Formula* formula;
+        ///< Shared formula node
+
+        Justification justification;
+        ///< Way the formula is derived
+
+        unsigned type;
+        ///< Axiom or premise type
+
+        unsigned implies;
+        ///< Antecedent lemma of a modus ponens
+
+        unsigned implication;
+        ///< Implication lemma of a modus ponens
+
+        unsigned depth;
+        ///< Modus ponens nesting
+    };
+
+    //! Deduction
+
+    /**
+     * Modus ponens application found by a search thread.
+     */
+    struct Deduction
+    {
+        unsigned implication;
+        ///< Implication lemma
+
+        unsigned implies;
+        ///< Antecedent lemma
+    };
+
+    const ProofSystem& system;
+    ///< Proof system providing the axioms
+
+    unsigned threads;
+    ///< Count of search threads
+
+    unsigned depthLimit;
+    ///< Greatest modus ponens nesting of a lemma and count of growths
+
+    unsigned sizeLimit;
+    ///< Greatest count of nodes of an axiom instance
+
+    unsigned lemmaLimit;
+    ///< Greatest count of lemmas
+
+    FormulaStore store;
+    ///< Store sharing the formulas
+
+    FormulaArena scratch;
+    ///< Arena of the axiom instances being built
+
+    std::vector<Formula*> universe;
+    ///< Subformulas of the premises, the goals and the derived implications
+
+    std::unordered_map<Formula*, unsigned> sizes;
+    ///< Node counts of the universe members
+
+    std::vector<unsigned> ordered;
+    ///< Positions of the universe members ordered by node count
+
+    unsigned instantiated = 0;
+    ///< Count of universe members the axioms are instantiated with
+
+    std::unordered_set<Formula*> goals;
+    ///< Goals and the antecedents of the implications deriving them
+
+    std::vector<Formula*> assumptions;
+    ///< Premises in the order of addition
+
+    std::vector<Lemma> lemmas;
+    ///< Lemmas in the derivation order
+
+    std::unordered_map<Formula*, unsigned> known;
+    ///< Lemmas by formula
+
+    std::unordered_map<Formula*, std::vector<unsigned>> implications;
+    ///< Implication lemmas by antecedent
+
+    std::vector<unsigned> frontier;
+    ///< Lemmas not combined with the others yet
+
+    std::vector<unsigned> current;
+    ///< Frontier lemmas being combined
+
+    std::vector<Range> ranges;
+    ///< Parts of the current frontier by thread
+
+    std::vector<std::vector<Deduction>> found;
+    ///< Modus ponens applications found by thread
+
+    std::vector<std::thread> workers;
+    ///< Pool of the search threads besides the calling one
+
+    std::mutex lock;
+    ///< Lock guarding the pool state below
+
+    std::condition_variable changed;
+    ///< Signalled on every pool state change
+
+    unsigned round = 0;
+    ///< Count of rounds given to the pool
+
+    unsigned active = 0;
+    ///< Count of pool threads still combining the current round
+
+    bool stopped = false;
+    ///< Pool stop request flag
+
+    /**
+     * Collects the distinct propositions of an axiom schema with their
+     * occurrence counts, and counts its connective nodes.
+     * @param formula Formula to be searched
+     * @param schema Schema whose propositions and connectives are to be counted
+     */
+    static void prepareSchema(Formula* formula,
+                              Schema& schema);
+
+    /**
+     * Adds the subformulas of given formula to the universe.
+     * @param formula Shared formula
+     * @return Node count of given formula
+     */
+    unsigned addMember(Formula* formula);
+
+    /**
+     * Adds a lemma unless its formula is known or there are too many.
+     * @param lemma Lemma to be added
+     * @return Lemma deriving the formula, NIL if there are too many
+     */
+    unsigned addLemma(const Lemma& lemma);
+
+    /**
+     * Adds an axiom lemma of given implication.
+     * @param antecedent Shared antecedent
+     * @param consequent Shared consequent
+     * @return Lemma deriving the implication, NIL if it is not an axiom or
+     * there are too many lemmas
+     */
+    unsigned addAxiom(Formula* antecedent,
+                      Formula* consequent);
+
+    /**
+     * Adds a modus ponens lemma.
+     * @param implies Antecedent lemma or NIL
+     * @param implication Implication lemma or NIL
+     * @return Lemma deriving the consequent, NIL if a witness is NIL or
+     * there are too many lemmas
+     */
+    unsigned addDeduction(unsigned implies,
+                          unsigned implication);
+
+    /**
+     * Returns the shared implication of given formulas.
+     * @param antecedent Shared antecedent
+     * @param consequent Shared consequent
+     * @return Shared implication
+     */
+    Formula* imply(Formula* antecedent,
+                   Formula* consequent);
+
+    /**
+     * Adds the axiom instances over the universe with at least one member
+     * not instantiated with yet.
+     */
+    void instantiate();
+
+    /**
+     * Adds the instances of an axiom schema binding the propositions from
+     * given one on, in the increasing node count of the universe members
+     * until the instances are too large.
+     * @param schema Axiom schema
+     * @param position Position of the proposition to be bound
+     * @param size Least node count of the instances
+     * @param fresh Member not instantiated with yet bound flag
+     * @param substitution Universe members bound to the earlier propositions
+     * @return False once there are too many lemmas
+     */
+    bool enumerate(const Schema& schema,
+                   unsigned position,
+                   unsigned size,
+                   bool fresh,
+                   Substitution& substitution);
+
+    /**
+     * Adds the implication lemmas (X>(Y>...(Z>G))) with a goal G and the
+     * lemmas Y to Z derived to the universe, and their antecedents X to the
+     * goals.
+     * @return True if the universe grew
+     */
+    bool grow();
+
+    /**
+     * Builds an axiom instance.
+     * @param schema Axiom schema
+     * @param substitution Universe members substituted for the propositions
+     * @return Instance allocated in the scratch arena
+     */
+    Formula* substitute(Formula* schema,
+                        const Substitution& substitution);
+
+    /**
+     * Finds the modus ponens applications of a frontier lemma deriving
+     * unknown formulas.
+     * @param lemma Frontier lemma
+     * @param deductions Storage for the applications found
+     */
+    void deduce(unsigned lemma,
+                std::vector<Deduction>& deductions) const;
+
+    /**
+     * Takes chunks of the current frontier from the range of given thread,
+     * then steals them from the others until none are left.
+     * @param thread Thread the range and the applications belong to
+     */
+    void deduceChunks(unsigned thread);
+
+    /**
+     * Combines the current frontier in each round given to the pool until
+     * stopped.
+     * @param thread Thread the range and the applications belong to
+     */
+    void work(unsigned thread);
+
+    /**
+     * Combines the frontier lemmas until given formula is derived or no
+     * more lemmas can be.
+     * @param goal Shared formula to be derived
+     */
+    void saturate(Formula* goal);
+
+    /**
+     * Derives given formula.
+     * @param goal Shared formula to be derived
+     * @return Lemma deriving given formula, NIL if none was found within
+     * the limits
+     */
+    unsigned derive(Formula* goal);
+
+    /**
+     * Derives given implication from its consequent proved with its
+     * antecedent as an additional premise, through the deduction theorem.
+     * @param goal Shared implication to be derived
+     * @return Lemma deriving given implication, NIL if none was found
+     * within the limits
+     */
+    unsigned discharge(Formula* goal);
+
+    /**
+     * Collects the lemmas given one depends on.
+     * @param lemma Lemma to be justified
+     * @return Lemmas in the derivation order, given one last
+     */
+    std::vector<unsigned> collect(unsigned lemma) const;
+
+    ProofSearch(const ProofSystem&,
+                unsigned,
+                unsigned,
+                unsigned,
+                unsigned);
+public:
+    /**
+     * Creates a search within the proof system, the jobs count and the
+     * search limits of given configuration.
+     * @param config Program configuration
+     */
+    ProofSearch(const Configuration& config);
+    ~ProofSearch();
+
+    /**
+     * Adds a premise.
+     * @param formula Premise formula, left owned by the caller
+     */
+    void addPremise(Formula* formula);
+
+    /**
+     * Searches for a proof of given formula.
+     * @param formula Goal formula, left owned by the caller
+     * @return Proof members in the proof order, owned by the caller,
+     * empty if no proof was found within the limits
+     */
+    std::vector<ProofMember*> prove(Formula* formula);
+};
+
+#endif
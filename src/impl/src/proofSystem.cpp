@@ -1,7 +1,12 @@
+#include <set>
 #include <sstream>
+#include <utility>
 
 #include "parseFormula.hpp"
 #include "proofSystem.hpp"
+#include "statistics.hpp"
+
+using namespace std;
 
 ProofSystem::ProofSystem(list<string> axiomStrings)
 {
@@ -10,79 +15,140 @@ ProofSystem::ProofSystem(list<string> axiomStrings)
     for (string axiomString : axiomStrings)
     {
         stream << axiomString << endl;
-        axioms.push_back(parseInfix(stream));
+        axioms.push_back(parseInfix(stream, arena));
+        index.insert(axioms.back(), axioms.size());
     }
 }
 
 ProofSystem::~ProofSystem()
 {
-    for (Formula* axiom : axioms)
-    {
-        delete axiom;
-    }
+}
+
+const vector<Formula*>& ProofSystem::getAxioms() const
+{
+    return axioms;
 }
 
 unsigned ProofSystem::isAxiom(Formula* formula) const
 {
-    map<char, Formula*> substitutions;
-    unsigned type = 1;
+    PhaseTimer timer(AXIOM_CHECKING);
+    Substitution substitution;
 
-    for (Formula* axiom : axioms)
+    for (unsigned type : index.find(formula))
     {
-        if (axiom->matches(formula, substitutions))
+        if (axioms[type - 1]->matches(formula, substitution))
         {
+            Statistics::countAxiom(type);
             return type;
         }
-        substitutions.clear();
-        type++;
+        substitution.clear();
     }
     return 0;
 }
 
+bool ProofSystem::isAxiom(Formula* formula,
+                          unsigned type) const
+{
+    PhaseTimer timer(AXIOM_CHECKING);
+    Substitution substitution;
+
+    if (type > 0 && type <= axioms.size()
+        && axioms[type - 1]->matches(formula, substitution))
+    {
+        Statistics::countAxiom(type);
+        return true;
+    }
+    return false;
+}
+
 HilbertSystem::HilbertSystem()
 : ProofSystem({"(A>(B>A))", "((A>(B>C))>((A>B)>(A>C)))", "((-A>-B)>(B>A))"})
 {
-    stringstream stream;
+    stringstream stream("(A>B)\n");
 
-    stream << "(A>B)" << endl;
-    modusPonens = parseInfix(stream);
+    modusPonens = parseInfix(stream, arena);
 }
 
-HilbertSystem::~HilbertSystem()
+list<unsigned> HilbertSystem::isDeducible(Formula* formula,
+                                          vector<ProofMember*>& proof,
+                                          ProofIndex& index) const
 {
-    delete modusPonens;
+    PhaseTimer timer(DEDUCING);
+    unsigned impliesIndex = 0;
+    unsigned implicationIndex = 0;
+
+    index.update();
+    for (unsigned candidate : index.findImplications(formula))
+    {
+        Statistics::count(DEDUCTION_PROBES);
+        Binary* implication = (Binary*) proof[candidate - 1]->getFormula();
+        unsigned implies = index.findMember(implication->getLeft());
+        if (implies > 0 && (impliesIndex == 0 || implies < impliesIndex))
+        {
+            impliesIndex = implies;
+            implicationIndex = candidate;
+        }
+    }
+    if (impliesIndex == 0)
+    {
+        return list<unsigned>();
+    }
+    return
+    {
+        impliesIndex, implicationIndex
+    };
 }
 
-list<unsigned> HilbertSystem::isDeducible(Formula* formula,
-                                          vector<ProofMember*>& proof) const
+bool HilbertSystem::isDeducible(Formula* formula,
+                                vector<ProofMember*>& proof,
+                                const list<unsigned>& witnesses) const
 {
-    map<char, Formula*> substitutions;
-    unsigned impliesIndex = 1;
-    unsigned implicationIndex = 1;
+    PhaseTimer timer(DEDUCING);
+    Substitution substitution;
 
-    for (ProofMember* implies : proof)
+    if (witnesses.size() != 2)
     {
-        for (ProofMember* implication : proof)
+        return false;
+    }
+    unsigned implies = witnesses.front();
+    unsigned implication = witnesses.back();
+    if (implies == 0 || implies > proof.size()
+        || implication == 0 || implication > proof.size())
+    {
+        return false;
+    }
+    substitution.set('A', proof[implies - 1]->getFormula());
+    substitution.set('B', formula);
+    return modusPonens->matches(proof[implication - 1]->getFormula(), substitution);
+}
+
+list<list<unsigned>> HilbertSystem::findDeductions(Formula* formula,
+                                                   vector<ProofMember*>& proof,
+                                                   ProofIndex& index,
+                                                   unsigned count) const
+{
+    PhaseTimer timer(DEDUCING);
+    set<pair<unsigned, unsigned>> pairs;
+    list<list<unsigned>> deductions;
+
+    index.update();
+    for (unsigned candidate : index.findImplications(formula))
+    {
+        if (candidate > count)
         {
-            if (impliesIndex == implicationIndex)
-            {
-                implicationIndex++;
-                continue;
-            }
-            substitutions.emplace('A', implies->getFormula());
-            substitutions.emplace('B', formula);
-            if (modusPonens->matches(implication->getFormula(), substitutions))
-            {
-                return
-                {
-                    impliesIndex, implicationIndex
-                };
-            }
-            substitutions.clear();
-            implicationIndex++;
+            break;
         }
-        impliesIndex++;
-        implicationIndex = 1;
+        Statistics::count(DEDUCTION_PROBES);
+        Binary* implication = (Binary*) proof[candidate - 1]->getFormula();
+        unsigned implies = index.findMember(implication->getLeft());
+        if (implies > 0 && implies <= count)
+        {
+            pairs.emplace(implies, index.findMember(implication));
+        }
+    }
+    for (const pair<unsigned, unsigned>& witnesses : pairs)
+    {
+        deductions.push_back({witnesses.first, witnesses.second});
     }
-    return list<unsigned>();
+    return deductions;
 }
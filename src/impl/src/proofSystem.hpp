@@ -5,11 +5,12 @@
 #include <string>
 #include <vector>
 
+#include "axiomIndex.hpp"
 #include "formula.hpp"
+#include "formulaArena.hpp"
+#include "proofIndex.hpp"
 #include "proofMember.hpp"
 
-using namespace std;
-
 //! Proof system
 
 /**
@@ -17,13 +18,25 @@ using namespace std;
  */
 class ProofSystem
 {
+protected:
+    FormulaArena arena;
+    ///< Arena owning the axioms and the deduction rules
 private:
-    list<Formula*> axioms;
+    std::vector<Formula*> axioms;
     ///< Proof system axioms
+
+    AxiomIndex index;
+    ///< Axioms discrimination tree
 public:
-    ProofSystem(list<string>);
+    ProofSystem(std::list<std::string>);
     virtual ~ProofSystem();
 
+    /**
+     * Axioms getter.
+     * @return Axiom schemas, the axiom type being the position from 1
+     */
+    const std::vector<Formula*>& getAxioms() const;
+
     /**
      * Verifies whether given formula is an axiom.
      * @param formula Formula to be verified as an axiom
@@ -31,14 +44,50 @@ public:
      */
     unsigned isAxiom(Formula* formula) const;
 
+    /**
+     * Verifies whether given formula is an axiom of given type.
+     * @param formula Formula to be verified as an axiom
+     * @param type Axiom type claimed for given formula
+     * @return True if given formula is an axiom of given type
+     */
+    bool isAxiom(Formula* formula,
+                 unsigned type) const;
+
     /**
      * Verifies whether given formula is deducible using the deduction rules.
      * @param formula Formula to be deduced within given proof
      * @param proof Proof within which given formula is to be deduced
+     * @param index Index kept alongside given proof
      * @return Deducing formulas indexes, empty when formula is not deducible
      */
-    virtual list<unsigned> isDeducible(Formula* formula,
-                                       vector<ProofMember*>& proof) const = 0;
+    virtual std::list<unsigned> isDeducible(Formula* formula,
+                                            std::vector<ProofMember*>& proof,
+                                            ProofIndex& index) const = 0;
+
+    /**
+     * Verifies whether given formula is deducible from given witnesses.
+     * @param formula Formula to be deduced within given proof
+     * @param proof Proof within which given formula is to be deduced
+     * @param witnesses Claimed deducing formulas indexes
+     * @return True if given witnesses deduce given formula
+     */
+    virtual bool isDeducible(Formula* formula,
+                             std::vector<ProofMember*>& proof,
+                             const std::list<unsigned>& witnesses) const = 0;
+
+    /**
+     * Finds all ways of deducing given formula using the deduction rules.
+     * @param formula Formula to be deduced within given proof
+     * @param proof Proof within which given formula is to be deduced
+     * @param index Index kept alongside given proof
+     * @param count Count of leading proof members usable as witnesses
+     * @return Deducing formulas indexes of each way, each witness being
+     * the first occurrence of its formula, in ascending order
+     */
+    virtual std::list<std::list<unsigned>> findDeductions(Formula* formula,
+                                                          std::vector<ProofMember*>& proof,
+                                                          ProofIndex& index,
+                                                          unsigned count) const = 0;
 };
 
 //! Hilbert's proof system
@@ -50,13 +99,20 @@ class HilbertSystem: public ProofSystem
 {
 private:
     Formula* modusPonens;
-    ///< Modus ponens implication formula
+    ///< Modus ponens rule implication
 public:
     HilbertSystem();
-    virtual ~HilbertSystem();
 
-    virtual list<unsigned> isDeducible(Formula*,
-                                       vector<ProofMember*>&) const;
+    virtual std::list<unsigned> isDeducible(Formula*,
+                                            std::vector<ProofMember*>&,
+                                            ProofIndex&) const;
+    virtual bool isDeducible(Formula*,
+                             std::vector<ProofMember*>&,
+                             const std::list<unsigned>&) const;
+    virtual std::list<std::list<unsigned>> findDeductions(Formula*,
+                                                          std::vector<ProofMember*>&,
+                                                          ProofIndex&,
+                                                          unsigned) const;
 };
 
 #endif
@@ -0,0 +1,458 @@
+#include <algorithm>
+
+#include "satSolver.hpp"
+
+using namespace std;
+
+const unsigned SatSolver::NIL;
+
+Literal SatSolver::makeLiteral(unsigned variable,
+                               bool negative)
+{
+    return variable * 2 + negative;
+}
+
+Literal SatSolver::negate(Literal literal)
+{
+    return literal ^ 1;
+}
+
+SatSolver::Value SatSolver::value(Literal literal) const
+{
+    Value assigned = values[literal / 2];
+
+    return assigned == UNASSIGNED ? UNASSIGNED : (Value) (assigned ^ (literal & 1));
+}
+
+unsigned SatSolver::newVariable()
+{
+    unsigned variable = values.size();
+
+    values.push_back(UNASSIGNED);
+    levels.push_back(0);
+    reasons.push_back(NIL);
+    phases.push_back(false);
+    seen.push_back(false);
+    decidable.push_back(false);
+    activities.push_back(0);
+    positions.push_back(NIL);
+    owned.emplace_back();
+    watches.emplace_back();
+    watches.emplace_back();
+    return variable;
+}
+
+void SatSolver::assign(Literal literal,
+                       unsigned reason)
+{
+    unsigned variable = literal / 2;
+
+    values[variable] = (Value) !(literal & 1);
+    levels[variable] = limits.size();
+    reasons[variable] = reason;
+    trail.push_back(literal);
+}
+
+unsigned SatSolver::store(const vector<Literal>& literals)
+{
+    clauses.push_back(literals);
+    owned[*max_element(literals.begin(), literals.end()) / 2].push_back(clauses.size() - 1);
+    return clauses.size() - 1;
+}
+
+bool SatSolver::attach(unsigned number)
+{
+    vector<Literal>& clause = clauses[number];
+    unsigned unassigned = 0;
+
+    for (unsigned index = 0; index < clause.size(); index++)
+    {
+        if (value(clause[index]) == TRUE_VALUE)
+        {
+            return true;
+        }
+        if (value(clause[index]) == UNASSIGNED && unassigned < 2)
+        {
+            swap(clause[unassigned++], clause[index]);
+        }
+    }
+    if (unassigned == 0)
+    {
+        return false;
+    }
+    if (unassigned == 1)
+    {
+        assign(clause[0], NIL);
+        return true;
+    }
+    watches[clause[0]].push_back(number);
+    watches[clause[1]].push_back(number);
+    active.push_back(number);
+    return true;
+}
+
+void SatSolver::detach()
+{
+    for (unsigned number : active)
+    {
+        watches[clauses[number][0]].clear();
+        watches[clauses[number][1]].clear();
+    }
+    active.clear();
+}
+
+void SatSolver::addClause(vector<Literal> literals)
+{
+    sort(literals.begin(), literals.end());
+    literals.erase(unique(literals.begin(), literals.end()), literals.end());
+    for (unsigned index = 1; index < literals.size(); index++)
+    {
+        if (literals[index - 1] == negate(literals[index]))
+        {
+            return;
+        }
+    }
+    store(literals);
+}
+
+unsigned SatSolver::propagate()
+{
+    while (propagated < trail.size())
+    {
+        Literal falsified = negate(trail[propagated++]);
+        vector<unsigned>& watchers = watches[falsified];
+        unsigned kept = 0;
+        for (unsigned index = 0; index < watchers.size(); index++)
+        {
+            unsigned number = watchers[index];
+            vector<Literal>& clause = clauses[number];
+            if (clause[0] == falsified)
+            {
+                swap(clause[0], clause[1]);
+            }
+            if (value(clause[0]) == TRUE_VALUE)
+            {
+                watchers[kept++] = number;
+                continue;
+            }
+
+            // Replacement watch search
+            bool moved = false;
+            for (unsigned other = 2; other < clause.size(); other++)
+            {
+                if (value(clause[other]) != FALSE_VALUE)
+                {
+                    swap(clause[1], clause[other]);
+                    watches[clause[1]].push_back(number);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved)
+            {
+                continue;
+            }
+
+            // Unit or conflicting clause
+            watchers[kept++] = number;
+            if (value(clause[0]) == FALSE_VALUE)
+            {
+                while (++index < watchers.size())
+                {
+                    watchers[kept++] = watchers[index];
+                }
+                watchers.resize(kept);
+                return number;
+            }
+            assign(clause[0], number);
+        }
+        watchers.resize(kept);
+    }
+    return NIL;
+}
+
+unsigned SatSolver::analyze(unsigned conflict,
+                            vector<Literal>& learnt)
+{
+    unsigned pending = 0;
+    unsigned index = trail.size();
+    Literal literal = NIL;
+
+    learnt.assign(1, NIL);
+    do
+    {
+        const vector<Literal>& clause = clauses[conflict];
+        for (unsigned other = literal == NIL ? 0 : 1; other < clause.size(); other++)
+        {
+            unsigned variable = clause[other] / 2;
+            if (!seen[variable] && levels[variable] > 0)
+            {
+                seen[variable] = true;
+                bump(variable);
+                if (levels[variable] == limits.size())
+                {
+                    pending++;
+                } else
+                {
+                    learnt.push_back(clause[other]);
+                }
+            }
+        }
+        while (!seen[trail[--index] / 2]);
+        literal = trail[index];
+        conflict = reasons[literal / 2];
+        seen[literal / 2] = false;
+    } while (--pending > 0);
+    learnt[0] = negate(literal);
+
+    // Backtrack level, its literal watched second
+    unsigned level = 0;
+    for (unsigned other = 1; other < learnt.size(); other++)
+    {
+        seen[learnt[other] / 2] = false;
+        if (levels[learnt[other] / 2] > level)
+        {
+            level = levels[learnt[other] / 2];
+            swap(learnt[1], learnt[other]);
+        }
+    }
+    increment /= 0.95;
+    return level;
+}
+
+void SatSolver::backtrack(unsigned level)
+{
+    if (limits.size() <= level)
+    {
+        return;
+    }
+    for (unsigned index = trail.size(); index-- > limits[level];)
+    {
+        unsigned variable = trail[index] / 2;
+        phases[variable] = values[variable] == TRUE_VALUE;
+        values[variable] = UNASSIGNED;
+        if (decidable[variable])
+        {
+            push(variable);
+        }
+    }
+    trail.resize(limits[level]);
+    limits.resize(level);
+    propagated = trail.size();
+}
+
+void SatSolver::bump(unsigned variable)
+{
+    if ((activities[variable] += increment) > 1e100)
+    {
+        for (double& activity : activities)
+        {
+            activity *= 1e-100;
+        }
+        increment *= 1e-100;
+    }
+    if (positions[variable] != NIL)
+    {
+        siftUp(positions[variable]);
+    }
+}
+
+void SatSolver::siftUp(unsigned position)
+{
+    unsigned variable = heap[position];
+
+    while (position > 0 && activities[heap[(position - 1) / 2]] < activities[variable])
+    {
+        heap[position] = heap[(position - 1) / 2];
+        positions[heap[position]] = position;
+        position = (position - 1) / 2;
+    }
+    heap[position] = variable;
+    positions[variable] = position;
+}
+
+void SatSolver::siftDown(unsigned position)
+{
+    unsigned variable = heap[position];
+
+    while (position * 2 + 1 < heap.size())
+    {
+        unsigned child = position * 2 + 1;
+        if (child + 1 < heap.size() && activities[heap[child + 1]] > activities[heap[child]])
+        {
+            child++;
+        }
+        if (activities[heap[child]] <= activities[variable])
+        {
+            break;
+        }
+        heap[position] = heap[child];
+        positions[heap[position]] = position;
+        position = child;
+    }
+    heap[position] = variable;
+    positions[variable] = position;
+}
+
+void SatSolver::push(unsigned variable)
+{
+    if (positions[variable] == NIL)
+    {
+        heap.push_back(variable);
+        siftUp(heap.size() - 1);
+    }
+}
+
+unsigned SatSolver::pop()
+{
+    unsigned variable = heap[0];
+
+    positions[variable] = NIL;
+    heap[0] = heap.back();
+    heap.pop_back();
+    if (!heap.empty())
+    {
+        siftDown(0);
+    }
+    return variable;
+}
+
+SatSolver::Value SatSolver::search(unsigned limit,
+                                   const vector<Literal>& assumptions)
+{
+    unsigned conflicts = 0;
+    vector<Literal> learnt;
+
+    while (true)
+    {
+        unsigned conflict = propagate();
+        if (conflict != NIL)
+        {
+            // Conflict learning
+            if (limits.empty())
+            {
+                return FALSE_VALUE;
+            }
+            conflicts++;
+            backtrack(analyze(conflict, learnt));
+            if (learnt.size() == 1)
+            {
+                assign(learnt[0], NIL);
+            } else
+            {
+                unsigned number = store(learnt);
+                watches[learnt[0]].push_back(number);
+                watches[learnt[1]].push_back(number);
+                active.push_back(number);
+                assign(learnt[0], number);
+            }
+            continue;
+        }
+        if (conflicts >= limit)
+        {
+            backtrack(0);
+            return UNASSIGNED;
+        }
+
+        // Next decision, the assumptions first
+        Literal decision = NIL;
+        while (limits.size() < assumptions.size())
+        {
+            Literal assumption = assumptions[limits.size()];
+            if (value(assumption) == FALSE_VALUE)
+            {
+                return FALSE_VALUE;
+            }
+            limits.push_back(trail.size());
+            if (value(assumption) == UNASSIGNED)
+            {
+                decision = assumption;
+                break;
+            }
+        }
+        while (decision == NIL && !heap.empty())
+        {
+            unsigned variable = pop();
+            if (values[variable] == UNASSIGNED)
+            {
+                limits.push_back(trail.size());
+                decision = makeLiteral(variable, !phases[variable]);
+            }
+        }
+        if (decision == NIL)
+        {
+            return TRUE_VALUE;
+        }
+        assign(decision, NIL);
+    }
+}
+
+unsigned SatSolver::luby(unsigned index)
+{
+    unsigned size = 1;
+    unsigned sequence = 0;
+
+    while (size < index + 1)
+    {
+        sequence++;
+        size = size * 2 + 1;
+    }
+    while (size - 1 != index)
+    {
+        size = (size - 1) / 2;
+        sequence--;
+        index %= size;
+    }
+    return 1u << sequence;
+}
+
+bool SatSolver::solve(const vector<Literal>& assumptions,
+                      const vector<unsigned>& variables)
+{
+    Value result = UNASSIGNED;
+
+    // Clauses over the decided variables attachment
+    for (unsigned variable : variables)
+    {
+        decidable[variable] = true;
+    }
+    for (unsigned variable : variables)
+    {
+        if (values[variable] == UNASSIGNED)
+        {
+            push(variable);
+        }
+        for (unsigned number : owned[variable])
+        {
+            bool usable = true;
+            for (Literal literal : clauses[number])
+            {
+                usable = usable && decidable[literal / 2];
+            }
+            if (usable && result == UNASSIGNED && !attach(number))
+            {
+                result = FALSE_VALUE;
+            }
+        }
+    }
+
+    // Search
+    for (unsigned restart = 0; result == UNASSIGNED; restart++)
+    {
+        result = search(luby(restart) * RESTART_UNIT, assumptions);
+    }
+
+    // Cleanup
+    backtrack(0);
+    detach();
+    for (unsigned variable : variables)
+    {
+        decidable[variable] = false;
+    }
+    for (unsigned variable : heap)
+    {
+        positions[variable] = NIL;
+    }
+    heap.clear();
+    return result == TRUE_VALUE;
+}
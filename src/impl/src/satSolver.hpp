@@ -0,0 +1,234 @@
+#ifndef SAT_SOLVER_HPP
+#define	SAT_SOLVER_HPP
+
+#include <vector>
+
+typedef unsigned Literal;
+///< Variable number doubled, plus one for the negative literal
+
+//! Satisfiability solver
+
+/**
+ * Conflict driven clause learning solver with two watched literals, VSIDS
+ * decisions, phase saving and Luby restarts. Each solve call decides given
+ * variables only and uses only the clauses over them, learnt clauses
+ * included, so that one solver serves many queries over a growing set of
+ * clauses without slowing down.
+ */
+class SatSolver
+{
+private:
+    static const unsigned NIL = ~0u;
+    ///< Missing clause or literal
+
+    static const unsigned RESTART_UNIT = 100;
+    ///< Conflicts count of the shortest restart interval
+
+    //! Truth value
+
+    /**
+     * Value of a variable or literal.
+     */
+    enum Value: signed char
+    {
+        FALSE_VALUE = 0, ///< Assigned false
+        TRUE_VALUE = 1, ///< Assigned true
+        UNASSIGNED = 2 ///< Not assigned yet
+    };
+
+    std::vector<std::vector<Literal>> clauses;
+    ///< Original and learnt clauses, the watched literals first
+
+    std::vector<std::vector<unsigned>> owned;
+    ///< Clauses of each variable being the greatest one of the clause
+
+    std::vector<unsigned> active;
+    ///< Clauses watched during the current solve call
+
+    std::vector<std::vector<unsigned>> watches;
+    ///< Clauses watching each literal
+
+    std::vector<Value> values;
+    ///< Variable values
+
+    std::vector<unsigned> levels;
+    ///< Decision levels of the assigned variables
+
+    std::vector<unsigned> reasons;
+    ///< Clauses implying the assigned variables, NIL for decisions
+
+    std::vector<bool> phases;
+    ///< Last values of the variables
+
+    std::vector<bool> seen;
+    ///< Conflict analysis marks of the variables
+
+    std::vector<bool> decidable;
+    ///< Variables decided by the current solve call
+
+    std::vector<Literal> trail;
+    ///< Assigned literals in the assignment order
+
+    std::vector<unsigned> limits;
+    ///< Trail sizes at the starts of the decision levels
+
+    unsigned propagated = 0;
+    ///< Count of trail literals propagated so far
+
+    std::vector<double> activities;
+    ///< Variable activities
+
+    double increment = 1;
+    ///< Activity bump amount
+
+    std::vector<unsigned> heap;
+    ///< Decidable variables by activity, a binary max-heap
+
+    std::vector<unsigned> positions;
+    ///< Heap positions of the variables, NIL when not in the heap
+
+    /**
+     * Returns the value of given literal.
+     * @param literal Literal to be evaluated
+     * @return Value of given literal
+     */
+    Value value(Literal literal) const;
+
+    /**
+     * Assigns given literal true.
+     * @param literal Literal to be assigned
+     * @param reason Clause implying given literal, NIL for a decision
+     */
+    void assign(Literal literal,
+                unsigned reason);
+
+    /**
+     * Stores a clause under its greatest variable.
+     * @param literals Clause literals
+     * @return Clause number
+     */
+    unsigned store(const std::vector<Literal>& literals);
+
+    /**
+     * Watches two unassigned literals of a stored clause, or assigns its
+     * only one, at the top decision level.
+     * @param number Clause number
+     * @return False if the clause is falsified
+     */
+    bool attach(unsigned number);
+
+    /**
+     * Removes the clauses watched during the current solve call from the
+     * watch lists.
+     */
+    void detach();
+
+    /**
+     * Propagates the unit clauses.
+     * @return Conflicting clause or NIL
+     */
+    unsigned propagate();
+
+    /**
+     * Derives a learnt clause from a conflict.
+     * @param conflict Conflicting clause
+     * @param learnt Storage for the learnt clause, asserting literal first
+     * @return Decision level to backtrack to
+     */
+    unsigned analyze(unsigned conflict,
+                     std::vector<Literal>& learnt);
+
+    /**
+     * Undoes the assignments above given decision level.
+     * @param level Decision level to keep
+     */
+    void backtrack(unsigned level);
+
+    /**
+     * Increases the activity of given variable.
+     * @param variable Variable to be bumped
+     */
+    void bump(unsigned variable);
+
+    /**
+     * Moves a variable up the heap while its activity is greater.
+     * @param position Heap position of the variable
+     */
+    void siftUp(unsigned position);
+
+    /**
+     * Moves a variable down the heap while its activity is smaller.
+     * @param position Heap position of the variable
+     */
+    void siftDown(unsigned position);
+
+    /**
+     * Inserts given variable into the heap unless already there.
+     * @param variable Variable to be inserted
+     */
+    void push(unsigned variable);
+
+    /**
+     * Removes the most active variable from the heap.
+     * @return Most active variable
+     */
+    unsigned pop();
+
+    /**
+     * Searches for a satisfying assignment until a conflicts limit.
+     * @param limit Count of conflicts to restart after
+     * @param assumptions Literals assumed true
+     * @return TRUE_VALUE if satisfiable, FALSE_VALUE if unsatisfiable and
+     * UNASSIGNED when the limit was reached
+     */
+    Value search(unsigned limit,
+                 const std::vector<Literal>& assumptions);
+
+    /**
+     * Computes an element of the Luby sequence.
+     * @param index Index of the element from 0
+     * @return Luby sequence element
+     */
+    static unsigned luby(unsigned index);
+public:
+    /**
+     * Creates a literal.
+     * @param variable Variable of the literal
+     * @param negative True for the negative literal
+     * @return Literal of given variable
+     */
+    static Literal makeLiteral(unsigned variable,
+                               bool negative);
+
+    /**
+     * Negates a literal.
+     * @param literal Literal to be negated
+     * @return Complementary literal
+     */
+    static Literal negate(Literal literal);
+
+    /**
+     * Creates a fresh variable.
+     * @return Variable number
+     */
+    unsigned newVariable();
+
+    /**
+     * Adds a clause, used by the solve calls deciding all of its variables.
+     * @param literals Clause literals of existing variables
+     */
+    void addClause(std::vector<Literal> literals);
+
+    /**
+     * Decides whether the clauses over given variables are satisfiable by
+     * an assignment making given literals true.
+     * @param assumptions Literals assumed true, of given variables
+     * @param variables Variables to be decided, each satisfying assignment
+     * of which must extend to a satisfying assignment of all the clauses
+     * @return True if satisfiable
+     */
+    bool solve(const std::vector<Literal>& assumptions,
+               const std::vector<unsigned>& variables);
+};
+
+#endif
@@ -0,0 +1,476 @@
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "socketServer.hpp"
+#include "usageException.hpp"
+
+using namespace std;
+
+//! Request body
+
+/**
+ * Verifies whether a request is followed by lines ending with a blank one.
+ * @param request Request line
+ * @return True if given request has a body
+ */
+static bool hasBody(const string& request)
+{
+    string keyword = request.substr(0, request.find(' '));
+
+    return keyword == "VERIFY" || keyword == "MINIMIZE";
+}
+
+SocketServer::SocketServer(Configuration& config,
+                           const string& path)
+: config(config), path(path)
+{
+}
+
+SocketServer::~SocketServer()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+        changed.notify_all();
+    }
+    for (thread& worker : workers)
+    {
+        worker.join();
+    }
+    while (!clients.empty())
+    {
+        close(clients.begin()->first);
+    }
+    for (int descriptor : {signals, wakeup, poller})
+    {
+        if (descriptor >= 0)
+        {
+            ::close(descriptor);
+        }
+    }
+    if (listener >= 0)
+    {
+        ::close(listener);
+        unlink(path.c_str());
+    }
+}
+
+void SocketServer::work()
+{
+    Context context(config);
+    uint64_t signal = 1;
+
+    while (true)
+    {
+        Task task;
+        {
+            unique_lock<mutex> guard(lock);
+            while (tasks.empty() && !stopping)
+            {
+                changed.wait(guard);
+            }
+            if (stopping)
+            {
+                return;
+            }
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        string response = handle(context, task);
+        {
+            lock_guard<mutex> guard(lock);
+            completions.push_back({task.client, task.number, move(response)});
+        }
+        while (write(wakeup, &signal, sizeof(signal)) < 0 && errno == EINTR)
+        {
+        }
+    }
+}
+
+string SocketServer::handle(Context& context,
+                            const Task& task)
+{
+    size_t blank = task.request.find(' ');
+    string keyword = task.request.substr(0, blank);
+    string argument = blank == string::npos ? "" : task.request.substr(blank + 1);
+    string output;
+    bool success = false;
+
+    try
+    {
+        if (keyword == "PARSE")
+        {
+            success = context.parse(argument, output);
+            output = success ? "" : output + '\n';
+        } else if (keyword == "PRINT")
+        {
+            success = context.print(argument, output);
+            output += '\n';
+        } else if (keyword == "AXIOM")
+        {
+            unsigned type = context.isAxiom(argument, output);
+            success = type > 0;
+            if (success)
+            {
+                output = "Axiom of type " + to_string(type) + ".\n";
+            } else
+            {
+                output = output.empty() ? "Not an axiom.\n" : output + '\n';
+            }
+        } else if (keyword == "VERIFY" || keyword == "MINIMIZE")
+        {
+            unsigned premises = Configuration::parseCount('-', argument.c_str(), 0, UINT_MAX);
+            if (keyword == "VERIFY")
+            {
+                success = context.verify(task.body, premises, output);
+            } else
+            {
+                success = context.minimize(task.body, premises, output);
+            }
+        } else
+        {
+            output = "Invalid request.\n";
+        }
+    } catch (UsageException& exception)
+    {
+        output = "Invalid request.\n";
+    }
+    return (success ? "OK " : "FAIL ") + to_string(count(output.begin(), output.end(), '\n'))
+        + '\n' + output;
+}
+
+bool SocketServer::watch(int descriptor,
+                         uint64_t identifier,
+                         uint32_t events)
+{
+    epoll_event event;
+
+    event.events = events;
+    event.data.u64 = identifier;
+    return epoll_ctl(poller, EPOLL_CTL_ADD, descriptor, &event) == 0;
+}
+
+bool SocketServer::update(uint64_t identifier,
+                          Client& client)
+{
+    epoll_event event;
+
+    event.events = (client.finished ? 0 : EPOLLIN) | (client.output.empty() ? 0 : EPOLLOUT);
+    event.data.u64 = identifier;
+    if (event.events == client.events)
+    {
+        return true;
+    }
+    client.events = event.events;
+    return epoll_ctl(poller, EPOLL_CTL_MOD, client.descriptor, &event) == 0;
+}
+
+void SocketServer::accept()
+{
+    int descriptor;
+
+    while ((descriptor = accept4(listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+    {
+        uint64_t identifier = nextClient++;
+        Client& client = clients[identifier];
+        client.descriptor = descriptor;
+        client.events = EPOLLIN;
+        if (!watch(descriptor, identifier, EPOLLIN))
+        {
+            close(identifier);
+        }
+    }
+}
+
+void SocketServer::receive(uint64_t identifier)
+{
+    Client& client = clients.at(identifier);
+    char buffer[READ_SIZE];
+    ssize_t count;
+
+    while ((count = read(client.descriptor, buffer, READ_SIZE)) > 0)
+    {
+        client.input.append(buffer, count);
+        if (client.input.size() > INPUT_LIMIT)
+        {
+            dispatch(identifier, client);
+        }
+        if (client.input.size() > INPUT_LIMIT || client.requests - client.responses > PENDING_LIMIT)
+        {
+            close(identifier);
+            return;
+        }
+    }
+    if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+    {
+        close(identifier);
+        return;
+    }
+    client.finished = count == 0;
+    dispatch(identifier, client);
+    if (client.requests - client.responses > PENDING_LIMIT)
+    {
+        close(identifier);
+        return;
+    }
+    if (client.finished)
+    {
+        send(identifier);
+    }
+}
+
+void SocketServer::dispatch(uint64_t identifier,
+                            Client& client)
+{
+    size_t start = 0;
+    bool queued = false;
+
+    // At the end of requests the remaining characters form the last request
+    while (start < client.input.size())
+    {
+        size_t newline = client.input.find('\n', start);
+        if (newline == string::npos && !client.finished)
+        {
+            break;
+        }
+        newline = min(newline, client.input.size());
+        Task task = {identifier, client.requests, client.input.substr(start, newline - start), ""};
+        size_t next = min(newline + 1, client.input.size());
+        if (hasBody(task.request))
+        {
+            size_t end = client.input.find("\n\n", newline);
+            if (end != string::npos)
+            {
+                task.body = client.input.substr(next, end + 1 - next);
+                next = end + 2;
+            } else if (client.finished)
+            {
+                task.body = client.input.substr(next);
+                if (!task.body.empty() && task.body.back() != '\n')
+                {
+                    task.body += '\n';
+                }
+                next = client.input.size();
+            } else
+            {
+                break;
+            }
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            tasks.push(move(task));
+        }
+        client.requests++;
+        start = next;
+        queued = true;
+    }
+    client.input.erase(0, start);
+    if (queued)
+    {
+        changed.notify_all();
+    }
+}
+
+void SocketServer::complete()
+{
+    vector<Completion> done;
+    uint64_t notifications;
+
+    while (read(wakeup, &notifications, sizeof(notifications)) < 0 && errno == EINTR)
+    {
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        done.swap(completions);
+    }
+    for (Completion& completion : done)
+    {
+        auto found = clients.find(completion.client);
+        if (found == clients.end())
+        {
+            continue;
+        }
+        Client& client = found->second;
+        client.ready.emplace(completion.number, move(completion.response));
+        for (auto next = client.ready.find(client.responses); next != client.ready.end();
+             next = client.ready.find(client.responses))
+        {
+            client.output += next->second;
+            client.ready.erase(next);
+            client.responses++;
+        }
+    }
+    for (Completion& completion : done)
+    {
+        if (clients.count(completion.client) > 0)
+        {
+            send(completion.client);
+        }
+        if (clients.count(completion.client) > 0
+            && clients.at(completion.client).output.size() > OUTPUT_LIMIT)
+        {
+            close(completion.client);
+        }
+    }
+}
+
+void SocketServer::send(uint64_t identifier)
+{
+    Client& client = clients.at(identifier);
+    size_t sent = 0;
+
+    while (sent < client.output.size())
+    {
+        ssize_t count = ::send(client.descriptor, client.output.data() + sent,
+                               client.output.size() - sent, MSG_NOSIGNAL);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            close(identifier);
+            return;
+        }
+        sent += count;
+    }
+    client.output.erase(0, sent);
+    if ((client.finished && client.output.empty() && client.responses == client.requests)
+        || !update(identifier, client))
+    {
+        close(identifier);
+    }
+}
+
+void SocketServer::close(uint64_t identifier)
+{
+    auto found = clients.find(identifier);
+
+    if (found != clients.end())
+    {
+        ::close(found->second.descriptor);
+        clients.erase(found);
+    }
+}
+
+int SocketServer::run()
+{
+    sockaddr_un address;
+    struct stat status;
+    sigset_t mask;
+    epoll_event events[EVENTS_SIZE];
+    bool running = true;
+
+    // Socket setup, replacing a stale socket file no server listens on
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        config.getErrors() << "Invalid socket path " << path << "." << endl;
+        return EXIT_FAILURE;
+    }
+    path.copy(address.sun_path, path.size());
+    if (stat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+    {
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (probe >= 0 && ::connect(probe, (sockaddr*) &address, sizeof(address)) != 0
+            && errno == ECONNREFUSED)
+        {
+            unlink(path.c_str());
+        }
+        if (probe >= 0)
+        {
+            ::close(probe);
+        }
+    }
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+    if ((poller = epoll_create1(EPOLL_CLOEXEC)) < 0
+        || (wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0
+        || (signals = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC)) < 0
+        || (listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0)
+    {
+        config.getErrors() << "Cannot serve on socket " << path << ": " << strerror(errno) << "." << endl;
+        return EXIT_FAILURE;
+    }
+    if (bind(listener, (sockaddr*) &address, sizeof(address)) != 0)
+    {
+        config.getErrors() << "Cannot serve on socket " << path << ": " << strerror(errno) << "." << endl;
+        ::close(listener);
+        listener = -1;
+        return EXIT_FAILURE;
+    }
+    if (listen(listener, SOMAXCONN) != 0 || !watch(listener, LISTENER, EPOLLIN)
+        || !watch(wakeup, WAKEUP, EPOLLIN) || !watch(signals, SIGNALS, EPOLLIN))
+    {
+        config.getErrors() << "Cannot serve on socket " << path << ": " << strerror(errno) << "." << endl;
+        return EXIT_FAILURE;
+    }
+
+    // Warm workers, each with its own proof system
+    for (unsigned worker = 0; worker < config.getJobs(); worker++)
+    {
+        workers.emplace_back(&SocketServer::work, this);
+    }
+
+    // Event loop
+    while (running)
+    {
+        int count = epoll_wait(poller, events, EVENTS_SIZE, -1);
+        if (count < 0 && errno != EINTR)
+        {
+            config.getErrors() << "Cannot serve on socket " << path << ": " << strerror(errno) << "." << endl;
+            return EXIT_FAILURE;
+        }
+        for (int index = 0; index < count; index++)
+        {
+            uint64_t identifier = events[index].data.u64;
+            switch (identifier)
+            {
+                case LISTENER:
+                    accept();
+                    break;
+                case WAKEUP:
+                    complete();
+                    break;
+                case SIGNALS:
+                    running = false;
+                    break;
+                default:
+                    if ((events[index].events & (EPOLLHUP | EPOLLERR)) != 0)
+                    {
+                        close(identifier);
+                    }
+                    if (clients.count(identifier) > 0
+                        && (events[index].events & EPOLLIN) != 0)
+                    {
+                        receive(identifier);
+                    }
+                    if (clients.count(identifier) > 0
+                        && (events[index].events & EPOLLOUT) != 0)
+                    {
+                        send(identifier);
+                    }
+                    break;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+#ifndef SOCKET_SERVER_HPP
+#define	SOCKET_SERVER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "configuration.hpp"
+#include "context.hpp"
+
+//! Socket server
+
+/**
+ * Serves requests of many clients over a Unix domain socket. One thread
+ * multiplexes the connections with epoll, while a pool of workers, each
+ * keeping its own context, handles the requests. Responses are sent in the
+ * request order of each client.
+ */
+class SocketServer
+{
+private:
+    static const size_t READ_SIZE = 65536;
+    ///< Count of bytes read from a client at once
+
+    static const size_t INPUT_LIMIT = 1 << 24;
+    ///< Count of received bytes not forming a whole request past which a
+    ///< client is closed
+
+    static const unsigned PENDING_LIMIT = 1024;
+    ///< Count of requests dispatched but not sent past which a client is
+    ///< closed
+
+    static const size_t OUTPUT_LIMIT = 1 << 24;
+    ///< Count of response bytes not sent past which a client is closed
+
+    static const unsigned EVENTS_SIZE = 64;
+    ///< Count of events waited for at once
+
+    static const uint64_t LISTENER = 0;
+    ///< Event identifier of the listening socket
+
+    static const uint64_t WAKEUP = 1;
+    ///< Event identifier of the completions notifier
+
+    static const uint64_t SIGNALS = 2;
+    ///< Event identifier of the termination signals
+
+    //! Client connection
+
+    /**
+     * Connection state of one client.
+     */
+    struct Client
+    {
+        int descriptor;
+        ///< Connected socket
+
+        std::string input;
+        ///< Received characters not forming a whole request yet
+
+        std::string output;
+        ///< Response characters not sent yet
+
+        unsigned requests = 0;
+        ///< Count of requests dispatched
+
+        unsigned responses = 0;
+        ///< Count of responses queued for sending
+
+        std::map<unsigned, std::string> ready;
+        ///< Responses completed ahead of their turn by request number
+
+        uint32_t events = 0;
+        ///< Watched events
+
+        bool finished = false;
+        ///< End of requests flag
+    };
+
+    //! Request task
+
+    /**
+     * Request handed to the workers.
+     */
+    struct Task
+    {
+        uint64_t client;
+        ///< Client identifier
+
+        unsigned number;
+        ///< Request number within the client
+
+        std::string request;
+        ///< Request line
+
+        std::string body;
+        ///< Lines following the request line
+    };
+
+    //! Request completion
+
+    /**
+     * Response handed back by the workers.
+     */
+    struct Completion
+    {
+        uint64_t client;
+        ///< Client identifier
+
+        unsigned number;
+        ///< Request number within the client
+
+        std::string response;
+        ///< Response characters
+    };
+
+    Configuration& config;
+    ///< Program configuration
+
+    std::string path;
+    ///< Socket file path
+
+    int listener = -1;
+    ///< Listening socket
+
+    int poller = -1;
+    ///< Epoll instance
+
+    int wakeup = -1;
+    ///< Event file notified of completions
+
+    int signals = -1;
+    ///< Signal file of the termination signals
+
+    std::unordered_map<uint64_t, Client> clients;
+    ///< Connected clients by identifier
+
+    uint64_t nextClient = SIGNALS + 1;
+    ///< Identifier of the next client
+
+    std::vector<std::thread> workers;
+    ///< Worker threads
+
+    std::mutex lock;
+    ///< Lock of the queues
+
+    std::condition_variable changed;
+    ///< Notified when a task is queued or the server stops
+
+    std::queue<Task> tasks;
+    ///< Requests waiting for a worker
+
+    std::vector<Completion> completions;
+    ///< Responses waiting for sending
+
+    bool stopping = false;
+    ///< Worker termination flag
+
+    /**
+     * Handles tasks until the server stops.
+     */
+    void work();
+
+    /**
+     * Handles a request.
+     * @param context Context of the handling worker
+     * @param task Request to be handled
+     * @return Response status line followed by the response lines
+     */
+    static std::string handle(Context& context,
+                              const Task& task);
+
+    /**
+     * Watches given descriptor for events.
+     * @param descriptor Descriptor to be watched
+     * @param identifier Event identifier
+     * @param events Events to be watched
+     * @return False if the descriptor cannot be watched
+     */
+    bool watch(int descriptor,
+               uint64_t identifier,
+               uint32_t events);
+
+    /**
+     * Watches the events a client connection is ready for.
+     * @param identifier Client identifier
+     * @param client Client connection
+     * @return False if the connection cannot be watched
+     */
+    bool update(uint64_t identifier,
+                Client& client);
+
+    /**
+     * Accepts the pending connections.
+     */
+    void accept();
+
+    /**
+     * Reads the characters sent by a client and dispatches its requests.
+     * @param identifier Client identifier
+     */
+    void receive(uint64_t identifier);
+
+    /**
+     * Queues the complete requests received from a client, and once it has
+     * finished, its remaining characters as the last request.
+     * @param identifier Client identifier
+     * @param client Client connection
+     */
+    void dispatch(uint64_t identifier,
+                  Client& client);
+
+    /**
+     * Moves the completed responses to their clients.
+     */
+    void complete();
+
+    /**
+     * Sends the queued responses of a client.
+     * @param identifier Client identifier
+     */
+    void send(uint64_t identifier);
+
+    /**
+     * Closes a client connection.
+     * @param identifier Client identifier
+     */
+    void close(uint64_t identifier);
+public:
+    SocketServer(Configuration&,
+                 const std::string&);
+    SocketServer(const SocketServer&) = delete;
+    ~SocketServer();
+
+    SocketServer& operator=(const SocketServer&) = delete;
+
+    /**
+     * Serves the clients until a termination signal.
+     * @return Program exit status
+     */
+    int run();
+};
+
+#endif
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
+#include "statistics.hpp"
+
+using namespace std;
+
+//! Counter names
+
+/**
+ * Report names of the counters.
+ */
+static const char* COUNTER_NAMES[COUNTERS] =
+{
+    "formulas_parsed",
+    "parse_errors.incomplete_formula",
+    "parse_errors.unexpected_eof",
+    "parse_errors.invalid_annotation",
+    "parse_errors.illegal_character",
+    "parse_errors.redundant_element",
+    "parse_errors.unexpected_element",
+    "matches_calls",
+    "equals_calls",
+    "deduction_probes",
+    "minimization_visits"
+};
+
+//! Phase names
+
+/**
+ * Report names of the phases.
+ */
+static const char* PHASE_NAMES[PHASES] =
+{
+    "parse",
+    "axiom_check",
+    "premise_check",
+    "deduction",
+    "minimize",
+    "print",
+    "handle"
+};
+
+bool Statistics::enabled = false;
+bool Statistics::tracing = false;
+chrono::steady_clock::time_point Statistics::epoch;
+mutex Statistics::lock;
+vector<Statistics::Counters*> Statistics::threads;
+thread_local Statistics::Counters* Statistics::local = NULL;
+
+Statistics::Counters& Statistics::counters()
+{
+    if (local == NULL)
+    {
+        local = new Counters();
+        lock_guard<mutex> guard(lock);
+        threads.push_back(local);
+    }
+    return *local;
+}
+
+void Statistics::enable()
+{
+    enabled = true;
+}
+
+void Statistics::enableTracing()
+{
+    tracing = true;
+    epoch = chrono::steady_clock::now();
+}
+
+void Statistics::countAxiom(unsigned type)
+{
+    if (enabled && type < AXIOM_TYPES)
+    {
+        counters().axiomHits[type]++;
+    }
+}
+
+void Statistics::countNodes(uint64_t nodes)
+{
+    if (enabled)
+    {
+        Counters& current = counters();
+        current.peakNodes = max(current.peakNodes, nodes);
+    }
+}
+
+void Statistics::addTime(Phase phase,
+                         chrono::steady_clock::time_point start,
+                         uint64_t nanoseconds)
+{
+    Counters& current = counters();
+
+    if (enabled)
+    {
+        current.nanoseconds[phase] += nanoseconds;
+    }
+    if (tracing)
+    {
+        current.events.push_back({phase, current.line,
+                                  (uint64_t) chrono::duration_cast<chrono::nanoseconds>(start - epoch).count(),
+                                  nanoseconds});
+    }
+}
+
+void Statistics::report(ostream& output)
+{
+    Counters total;
+    lock_guard<mutex> guard(lock);
+
+    for (Counters* thread : threads)
+    {
+        for (unsigned counter = 0; counter < COUNTERS; counter++)
+        {
+            total.counts[counter] += thread->counts[counter];
+        }
+        for (unsigned type = 0; type < AXIOM_TYPES; type++)
+        {
+            total.axiomHits[type] += thread->axiomHits[type];
+        }
+        for (unsigned phase = 0; phase < PHASES; phase++)
+        {
+            total.nanoseconds[phase] += thread->nanoseconds[phase];
+        }
+        total.peakNodes = max(total.peakNodes, thread->peakNodes);
+    }
+    for (unsigned counter = 0; counter < COUNTERS; counter++)
+    {
+        output << COUNTER_NAMES[counter] << " " << total.counts[counter] << endl;
+    }
+    for (unsigned type = 1; type < AXIOM_TYPES; type++)
+    {
+        if (total.axiomHits[type] > 0)
+        {
+            output << "axiom_hits." << type << " " << total.axiomHits[type] << endl;
+        }
+    }
+    output << "peak_nodes " << total.peakNodes << endl;
+    output << "threads " << threads.size() << endl;
+    for (unsigned phase = 0; phase < PHASES; phase++)
+    {
+        output << "time." << PHASE_NAMES[phase] << " " << fixed << setprecision(6)
+               << total.nanoseconds[phase] / 1e9 << endl;
+    }
+}
+
+void Statistics::writeTrace(ostream& output)
+{
+    vector<uint64_t> latencies;
+    map<uint64_t, uint64_t> histogram;
+    bool first = true;
+    lock_guard<mutex> guard(lock);
+
+    // Complete events of each thread, timestamps in microseconds
+    output << "{\"traceEvents\":[";
+    for (unsigned thread = 0; thread < threads.size(); thread++)
+    {
+        for (const TraceEvent& event : threads[thread]->events)
+        {
+            output << (first ? "\n{" : ",\n{");
+            first = false;
+            output << "\"name\":\"" << PHASE_NAMES[event.phase] << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                   << thread << ",\"ts\":" << event.start / 1000 << "." << setw(3) << setfill('0')
+                   << event.start % 1000 << ",\"dur\":" << event.duration / 1000 << "." << setw(3)
+                   << event.duration % 1000;
+            if (event.line > 0)
+            {
+                output << ",\"args\":{\"line\":" << event.line << "}";
+            }
+            output << "}";
+            if (event.phase == HANDLING)
+            {
+                latencies.push_back(event.duration);
+            }
+        }
+    }
+
+    // Line latency percentiles and power of two microseconds histogram
+    sort(latencies.begin(), latencies.end());
+    for (uint64_t latency : latencies)
+    {
+        uint64_t bound = 1;
+        while (bound * 1000 < latency)
+        {
+            bound *= 2;
+        }
+        histogram[bound]++;
+    }
+    output << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"lines\":" << latencies.size();
+    if (!latencies.empty())
+    {
+        output << ",\"latency_us\":{";
+        for (unsigned percentile : {50, 90, 99})
+        {
+            size_t rank = (latencies.size() * percentile + 99) / 100;
+            output << "\"p" << percentile << "\":" << latencies[max(rank, (size_t) 1) - 1] / 1e3 << ",";
+        }
+        output << "\"max\":" << latencies.back() / 1e3 << "},\"histogram_us\":{";
+        for (auto bucket = histogram.begin(); bucket != histogram.end(); bucket++)
+        {
+            output << (bucket == histogram.begin() ? "" : ",") << "\"" << bucket->first << "\":" << bucket->second;
+        }
+        output << "}";
+    }
+    output << "}}" << endl;
+}
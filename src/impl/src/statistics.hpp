@@ -0,0 +1,272 @@
+#ifndef STATISTICS_HPP
+#define	STATISTICS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+//! Statistics counter
+
+/**
+ * Events counted by the statistics.
+ */
+enum Counter
+{
+    FORMULAS_PARSED, ///< Formulas parsed
+    INCOMPLETE_FORMULAS, ///< Incomplete formula exceptions
+    UNEXPECTED_EOFS, ///< Unexpected end of stream exceptions
+    INVALID_ANNOTATIONS, ///< Invalid annotation exceptions
+    ILLEGAL_CHARACTERS, ///< Illegal character exceptions
+    REDUNDANT_ELEMENTS, ///< Redundant element exceptions
+    UNEXPECTED_ELEMENTS, ///< Unexpected element exceptions
+    MATCHES_CALLS, ///< Formula matches calls
+    EQUALS_CALLS, ///< Formula equals calls
+    DEDUCTION_PROBES, ///< Implications probed by the deduction search
+    MINIMIZATION_VISITS, ///< Proof members visited by the minimization
+    COUNTERS ///< Count of the counters
+};
+
+//! Statistics phase
+
+/**
+ * Program phases timed by the statistics.
+ */
+enum Phase
+{
+    PARSING, ///< Formula parsing
+    AXIOM_CHECKING, ///< Axiom checking
+    PREMISE_CHECKING, ///< Premise checking
+    DEDUCING, ///< Deduction search
+    MINIMIZING, ///< Proof minimization
+    PRINTING, ///< Formula printing
+    HANDLING, ///< Input line handling as a whole
+    PHASES ///< Count of the phases
+};
+
+//! Program statistics
+
+/**
+ * Counters, phase times and trace events kept by each thread on its own,
+ * without locking, and summed up or written when reported. Disabled
+ * statistics cost one branch per event.
+ */
+class Statistics
+{
+private:
+    static const unsigned AXIOM_TYPES = 16;
+    ///< Count of the axiom types whose hits are counted
+
+    //! Trace event
+
+    /**
+     * Phase run of one input line.
+     */
+    struct TraceEvent
+    {
+        Phase phase;
+        ///< Phase run
+
+        unsigned line;
+        ///< Input line number, 0 outside the lines
+
+        uint64_t start;
+        ///< Start in nanoseconds since the tracing was enabled
+
+        uint64_t duration;
+        ///< Wall time in nanoseconds
+    };
+
+    //! Thread counters
+
+    /**
+     * Statistics of one thread.
+     */
+    struct Counters
+    {
+        uint64_t counts[COUNTERS] = {};
+        ///< Event counts
+
+        uint64_t axiomHits[AXIOM_TYPES] = {};
+        ///< Axiom hits by type
+
+        uint64_t nanoseconds[PHASES] = {};
+        ///< Phase wall times
+
+        uint64_t peakNodes = 0;
+        ///< Greatest count of formula nodes held by an arena
+
+        unsigned line = 0;
+        ///< Input line being handled
+
+        std::vector<TraceEvent> events;
+        ///< Trace events in the order of completion
+    };
+
+    static bool enabled;
+    ///< Statistics enabled flag
+
+    static bool tracing;
+    ///< Tracing enabled flag
+
+    static std::chrono::steady_clock::time_point epoch;
+    ///< Time the tracing was enabled at
+
+    static std::mutex lock;
+    ///< Lock of the thread counters registry
+
+    static std::vector<Counters*> threads;
+    ///< Counters of all threads
+
+    static thread_local Counters* local;
+    ///< Counters of the current thread
+
+    /**
+     * Returns the counters of the current thread, registering them first.
+     * @return Counters of the current thread
+     */
+    static Counters& counters();
+public:
+    /**
+     * Enables the statistics, before any thread is started.
+     */
+    static void enable();
+
+    /**
+     * Statistics enabled flag getter.
+     * @return True if the statistics are enabled
+     */
+    static bool isEnabled();
+
+    /**
+     * Enables the trace events recording, before any thread is started.
+     */
+    static void enableTracing();
+
+    /**
+     * Tracing enabled flag getter.
+     * @return True if the trace events are recorded
+     */
+    static bool isTracing();
+
+    /**
+     * Sets the input line the current thread handles.
+     * @param line Input line number from 1
+     */
+    static void setLine(unsigned line);
+
+    /**
+     * Counts an event.
+     * @param counter Counter of the event
+     */
+    static void count(Counter counter);
+
+    /**
+     * Counts an axiom hit.
+     * @param type Axiom type hit
+     */
+    static void countAxiom(unsigned type);
+
+    /**
+     * Records a count of formula nodes held by an arena.
+     * @param nodes Count of nodes
+     */
+    static void countNodes(uint64_t nodes);
+
+    /**
+     * Adds a phase run to the phase time and to the trace events.
+     * @param phase Phase run
+     * @param start Start of the run
+     * @param nanoseconds Wall time in nanoseconds
+     */
+    static void addTime(Phase phase,
+                        std::chrono::steady_clock::time_point start,
+                        uint64_t nanoseconds);
+
+    /**
+     * Prints the statistics summed over all threads, one value per line.
+     * @param output Stream to print to
+     */
+    static void report(std::ostream& output);
+
+    /**
+     * Writes the trace events of all threads in the Chrome trace event
+     * format, with the percentiles and the histogram of the line latencies.
+     * @param output Stream to write to
+     */
+    static void writeTrace(std::ostream& output);
+};
+
+//! Phase timer
+
+/**
+ * Adds the wall time of its scope to a phase when the statistics or the
+ * tracing are enabled.
+ */
+class PhaseTimer
+{
+private:
+    Phase phase;
+    ///< Timed phase
+
+    bool running;
+    ///< Timing flag
+
+    std::chrono::steady_clock::time_point start;
+    ///< Start of the scope
+public:
+    PhaseTimer(Phase);
+    PhaseTimer(const PhaseTimer&) = delete;
+    ~PhaseTimer();
+
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+};
+
+// Hot path members inlined into the callers
+
+inline bool Statistics::isEnabled()
+{
+    return enabled;
+}
+
+inline bool Statistics::isTracing()
+{
+    return tracing;
+}
+
+inline void Statistics::setLine(unsigned line)
+{
+    if (tracing)
+    {
+        counters().line = line;
+    }
+}
+
+inline void Statistics::count(Counter counter)
+{
+    if (enabled)
+    {
+        counters().counts[counter]++;
+    }
+}
+
+inline PhaseTimer::PhaseTimer(Phase phase)
+: phase(phase), running(Statistics::isEnabled() || Statistics::isTracing())
+{
+    if (running)
+    {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+inline PhaseTimer::~PhaseTimer()
+{
+    if (running)
+    {
+        Statistics::addTime(phase, start, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+#endif
@@ -0,0 +1,29 @@
+#include <cstddef>
+
+#include "substitution.hpp"
+
+using namespace std;
+
+Substitution::Substitution()
+{
+    clear();
+}
+
+Formula* Substitution::get(char proposition) const
+{
+    return formulas[proposition - 'A'];
+}
+
+void Substitution::set(char proposition,
+                       Formula* formula)
+{
+    formulas[proposition - 'A'] = formula;
+}
+
+void Substitution::clear()
+{
+    for (Formula*& formula : formulas)
+    {
+        formula = NULL;
+    }
+}
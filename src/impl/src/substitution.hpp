@@ -0,0 +1,40 @@
+#ifndef SUBSTITUTION_HPP
+#define	SUBSTITUTION_HPP
+
+class Formula;
+
+//! Propositions substitution
+
+/**
+ * Formulas substituted for the propositions A-Z, indexed by proposition.
+ */
+class Substitution
+{
+private:
+    Formula* formulas['Z' - 'A' + 1];
+    ///< Substituted formulas, NULL for unbound propositions
+public:
+    Substitution();
+
+    /**
+     * Substituted formula getter.
+     * @param proposition Proposition to be looked up
+     * @return Formula substituted for given proposition or NULL
+     */
+    Formula* get(char proposition) const;
+
+    /**
+     * Substituted formula setter.
+     * @param proposition Proposition to be bound
+     * @param formula Formula to be substituted for given proposition
+     */
+    void set(char proposition,
+             Formula* formula);
+
+    /**
+     * Unbinds all propositions.
+     */
+    void clear();
+};
+
+#endif
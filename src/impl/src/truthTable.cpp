@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "truthTable.hpp"
+
+using namespace std;
+
+//! Variable patterns
+
+/**
+ * Truth values of the variables changing within a word.
+ */
+static const uint64_t PATTERNS[6] =
+{
+    0xAAAAAAAAAAAAAAAAull,
+    0xCCCCCCCCCCCCCCCCull,
+    0xF0F0F0F0F0F0F0F0ull,
+    0xFF00FF00FF00FF00ull,
+    0xFFFF0000FFFF0000ull,
+    0xFFFFFFFF00000000ull
+};
+
+TruthTable::TruthTable(const FlatFormula& formula)
+{
+    char numbers['Z' - 'A' + 1];
+    unsigned height = 0;
+
+    fill(numbers, numbers + ('Z' - 'A' + 1), -1);
+    for (unsigned position = formula.size(); position-- > 0;)
+    {
+        char code = formula.getCode(position);
+        switch (code)
+        {
+            case '-':
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                height--;
+                break;
+            default:
+                if (numbers[code - 'A'] < 0)
+                {
+                    numbers[code - 'A'] = variables++;
+                }
+                code = numbers[code - 'A'];
+                depth = max(depth, ++height);
+                break;
+        }
+        program.push_back(code);
+    }
+}
+
+unsigned TruthTable::getVariables() const
+{
+    return variables;
+}
+
+bool TruthTable::isParallel() const
+{
+    return variables >= PARALLEL_VARIABLES;
+}
+
+Satisfiability TruthTable::evaluate(unsigned threads) const
+{
+    uint64_t words = variables > 6 ? (uint64_t) 1 << (variables - 6) : 1;
+    uint64_t blocks = (words + LANES - 1) / LANES;
+    atomic<bool> satisfied(false);
+    atomic<bool> falsified(false);
+
+    if (!isParallel() || threads <= 1)
+    {
+        evaluateBlocks(0, blocks, satisfied, falsified);
+    } else
+    {
+        vector<thread> workers;
+        for (unsigned worker = 0; worker < threads; worker++)
+        {
+            workers.emplace_back(&TruthTable::evaluateBlocks,
+                                 this,
+                                 blocks * worker / threads,
+                                 blocks * (worker + 1) / threads,
+                                 ref(satisfied),
+                                 ref(falsified));
+        }
+        for (thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+    if (!falsified)
+    {
+        return TAUTOLOGY;
+    }
+    return satisfied ? SATISFIABLE : UNSATISFIABLE;
+}
+
+void TruthTable::evaluateBlocks(uint64_t first,
+                                uint64_t last,
+                                atomic<bool>& satisfied,
+                                atomic<bool>& falsified) const
+{
+    uint64_t words = variables > 6 ? (uint64_t) 1 << (variables - 6) : 1;
+    uint64_t mask = variables >= 6 ? ~(uint64_t) 0 : ((uint64_t) 1 << (1 << variables)) - 1;
+    vector<Lanes> stack(depth);
+
+    for (uint64_t block = first; block < last; block++)
+    {
+        if (satisfied && falsified)
+        {
+            return;
+        }
+
+        // Program execution
+        unsigned top = 0;
+        for (char code : program)
+        {
+            switch (code)
+            {
+                case '-':
+                {
+                    Lanes& operand = stack[top - 1];
+                    for (unsigned lane = 0; lane < LANES; lane++)
+                    {
+                        operand[lane] = ~operand[lane];
+                    }
+                    break;
+                }
+                case '.':
+                {
+                    Lanes& left = stack[top - 1];
+                    Lanes& right = stack[top - 2];
+                    for (unsigned lane = 0; lane < LANES; lane++)
+                    {
+                        right[lane] = left[lane] & right[lane];
+                    }
+                    top--;
+                    break;
+                }
+                case '+':
+                {
+                    Lanes& left = stack[top - 1];
+                    Lanes& right = stack[top - 2];
+                    for (unsigned lane = 0; lane < LANES; lane++)
+                    {
+                        right[lane] = left[lane] | right[lane];
+                    }
+                    top--;
+                    break;
+                }
+                case '>':
+                {
+                    Lanes& left = stack[top - 1];
+                    Lanes& right = stack[top - 2];
+                    for (unsigned lane = 0; lane < LANES; lane++)
+                    {
+                        right[lane] = ~left[lane] | right[lane];
+                    }
+                    top--;
+                    break;
+                }
+                case '=':
+                {
+                    Lanes& left = stack[top - 1];
+                    Lanes& right = stack[top - 2];
+                    for (unsigned lane = 0; lane < LANES; lane++)
+                    {
+                        right[lane] = ~(left[lane] ^ right[lane]);
+                    }
+                    top--;
+                    break;
+                }
+                default:
+                {
+                    Lanes& value = stack[top++];
+                    if (code < 6)
+                    {
+                        value.fill(PATTERNS[(unsigned) code]);
+                    } else
+                    {
+                        for (unsigned lane = 0; lane < LANES; lane++)
+                        {
+                            value[lane] = -(((block * LANES + lane) >> (code - 6)) & 1);
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+
+        // Result collection
+        uint64_t trueBits = 0;
+        uint64_t falseBits = 0;
+        for (unsigned lane = 0; lane < LANES; lane++)
+        {
+            uint64_t valid = block * LANES + lane < words ? mask : 0;
+            trueBits |= stack[0][lane] & valid;
+            falseBits |= ~stack[0][lane] & valid;
+        }
+        if (trueBits != 0 && !satisfied)
+        {
+            satisfied = true;
+        }
+        if (falseBits != 0 && !falsified)
+        {
+            falsified = true;
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef TRUTH_TABLE_HPP
+#define	TRUTH_TABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "flatFormula.hpp"
+
+//! Formula satisfiability
+
+/**
+ * Classification of a formula by its truth values.
+ */
+enum Satisfiability
+{
+    TAUTOLOGY, ///< True under all assignments
+    SATISFIABLE, ///< True under some assignments only
+    UNSATISFIABLE ///< False under all assignments
+};
+
+//! Truth table
+
+/**
+ * Formula compiled to a postfix program evaluating the formula under 64
+ * assignments per machine word, several words at once.
+ */
+class TruthTable
+{
+private:
+    static const unsigned LANES = 8;
+    ///< Count of words evaluated at once
+
+    static const unsigned PARALLEL_VARIABLES = 20;
+    ///< Least variables count evaluated on several threads
+
+    typedef std::array<uint64_t, LANES> Lanes;
+    ///< Truth values of consecutive assignments
+
+    std::vector<char> program;
+    ///< Representing characters in postfix order, propositions replaced
+    ///< by their variable numbers
+
+    unsigned variables = 0;
+    ///< Count of distinct propositions
+
+    unsigned depth = 0;
+    ///< Evaluation stack size
+
+    /**
+     * Evaluates the formula on given range of assignment blocks, stopping
+     * once it is known to be neither tautology nor unsatisfiable.
+     * @param first The first block to evaluate
+     * @param last Block past the last one to evaluate
+     * @param satisfied Flag set when a satisfying assignment is found
+     * @param falsified Flag set when a falsifying assignment is found
+     */
+    void evaluateBlocks(uint64_t first,
+                        uint64_t last,
+                        std::atomic<bool>& satisfied,
+                        std::atomic<bool>& falsified) const;
+public:
+    TruthTable(const FlatFormula&);
+
+    /**
+     * Variables count getter.
+     * @return Count of distinct propositions
+     */
+    unsigned getVariables() const;
+
+    /**
+     * Verifies whether the evaluation is spread over several threads.
+     * @return True if there are enough propositions for several threads
+     */
+    bool isParallel() const;
+
+    /**
+     * Evaluates the formula under all assignments of its propositions.
+     * @param threads Count of threads to use for many propositions
+     * @return Satisfiability of the formula
+     */
+    Satisfiability evaluate(unsigned threads) const;
+};
+
+#endif
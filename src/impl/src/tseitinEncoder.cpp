@@ -0,0 +1,155 @@
+#include <unordered_set>
+
+#include "tseitinEncoder.hpp"
+
+using namespace std;
+
+//! Encode step
+
+/**
+ * Pending node of the iterative encoding.
+ */
+struct EncodeStep
+{
+    Formula* formula;
+    ///< Shared node to be encoded
+
+    bool expanded;
+    ///< Whether the operands have been scheduled already
+};
+
+static thread_local vector<EncodeStep> steps;
+///< Encode steps stack reused by the encoders of each thread
+
+static thread_local vector<Literal> operands;
+///< Operand literals stack reused by the encoders of each thread
+
+TseitinEncoder::TseitinEncoder(SatSolver& solver)
+: solver(solver)
+{
+}
+
+Literal TseitinEncoder::encode(Formula* formula,
+                              vector<unsigned>& variables)
+{
+    Formula* shared = store.intern(formula);
+    Literal literal = encodeShared(shared);
+    unordered_set<Formula*> visited;
+    vector<Formula*> pending(1, shared);
+
+    // Subformulas variables collection
+    variables.clear();
+    while (!pending.empty())
+    {
+        Formula* subformula = pending.back();
+        pending.pop_back();
+        if (!visited.insert(subformula).second)
+        {
+            continue;
+        }
+        switch (subformula->getCharacter())
+        {
+            case '-':
+                pending.push_back(((Unary*) subformula)->getOperand());
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                variables.push_back(literals.at(subformula) / 2);
+                pending.push_back(((Binary*) subformula)->getLeft());
+                pending.push_back(((Binary*) subformula)->getRight());
+                break;
+            default:
+                variables.push_back(literals.at(subformula) / 2);
+                break;
+        }
+    }
+    return literal;
+}
+
+Literal TseitinEncoder::encodeShared(Formula* formula)
+{
+    Literal result;
+    Literal left;
+    Literal right;
+
+    steps.push_back({formula, false});
+    while (!steps.empty())
+    {
+        EncodeStep step = steps.back();
+        char character = step.formula->getCharacter();
+
+        steps.pop_back();
+        if (!step.expanded)
+        {
+            auto known = literals.find(step.formula);
+            if (known != literals.end())
+            {
+                operands.push_back(known->second);
+                continue;
+            }
+            if (character == '-')
+            {
+                steps.push_back({step.formula, true});
+                steps.push_back({((Unary*) step.formula)->getOperand(), false});
+                continue;
+            } else if (character < 'A' || character > 'Z')
+            {
+                steps.push_back({step.formula, true});
+                steps.push_back({((Binary*) step.formula)->getRight(), false});
+                steps.push_back({((Binary*) step.formula)->getLeft(), false});
+                continue;
+            }
+        }
+        switch (character)
+        {
+            case '-':
+                result = SatSolver::negate(operands.back());
+                operands.pop_back();
+                break;
+            case '.':
+            case '+':
+            case '>':
+            case '=':
+                right = operands.back();
+                operands.pop_back();
+                left = operands.back();
+                operands.pop_back();
+                result = SatSolver::makeLiteral(solver.newVariable(), false);
+                switch (character)
+                {
+                    case '.':
+                        solver.addClause({SatSolver::negate(result), left});
+                        solver.addClause({SatSolver::negate(result), right});
+                        solver.addClause({result, SatSolver::negate(left), SatSolver::negate(right)});
+                        break;
+                    case '+':
+                        solver.addClause({SatSolver::negate(result), left, right});
+                        solver.addClause({result, SatSolver::negate(left)});
+                        solver.addClause({result, SatSolver::negate(right)});
+                        break;
+                    case '>':
+                        solver.addClause({SatSolver::negate(result), SatSolver::negate(left), right});
+                        solver.addClause({result, left});
+                        solver.addClause({result, SatSolver::negate(right)});
+                        break;
+                    case '=':
+                        solver.addClause({SatSolver::negate(result), SatSolver::negate(left), right});
+                        solver.addClause({SatSolver::negate(result), left, SatSolver::negate(right)});
+                        solver.addClause({result, left, right});
+                        solver.addClause({result, SatSolver::negate(left), SatSolver::negate(right)});
+                        break;
+                }
+                break;
+            default:
+                result = SatSolver::makeLiteral(solver.newVariable(), false);
+                break;
+        }
+        literals.emplace(step.formula, result);
+        operands.push_back(result);
+    }
+    result = operands.back();
+    operands.pop_back();
+    return result;
+}
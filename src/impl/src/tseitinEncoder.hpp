@@ -0,0 +1,49 @@
+#ifndef TSEITIN_ENCODER_HPP
+#define	TSEITIN_ENCODER_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include "formula.hpp"
+#include "formulaStore.hpp"
+#include "satSolver.hpp"
+
+//! Tseitin encoder
+
+/**
+ * Encodes formulas into the clauses of a solver, one variable per distinct
+ * subformula. Subformulas repeated within or across formulas share their
+ * variable and clauses.
+ */
+class TseitinEncoder
+{
+private:
+    SatSolver& solver;
+    ///< Solver receiving the clauses
+
+    FormulaStore store;
+    ///< Store sharing the encoded subformulas
+
+    std::unordered_map<Formula*, Literal> literals;
+    ///< Literals of the encoded shared subformulas
+
+    /**
+     * Encodes a shared subformula, its operands first without recursion.
+     * @param formula Subformula interned in the store
+     * @return Literal equivalent to given subformula
+     */
+    Literal encodeShared(Formula* formula);
+public:
+    TseitinEncoder(SatSolver&);
+
+    /**
+     * Encodes given formula.
+     * @param formula Formula to be encoded, left owned by the caller
+     * @param variables Storage for the variables of the formula subformulas
+     * @return Literal equivalent to given formula
+     */
+    Literal encode(Formula* formula,
+                   std::vector<unsigned>& variables);
+};
+
+#endif
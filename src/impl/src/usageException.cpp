@@ -1,5 +1,7 @@
 #include "usageException.hpp"
 
+using namespace std;
+
 UsageException::UsageException(char option,
                                string message)
 : option(option), message(message)
@@ -3,8 +3,6 @@
 
 #include <string>
 
-using namespace std;
-
 //! Program syntax exception
 
 /**
@@ -16,17 +14,17 @@ private:
     char option;
     ///< Erroneous option
 
-    string message;
+    std::string message;
     ///< Exception details
 public:
     UsageException(char,
-                   string);
+                   std::string);
 
     /**
      * Composes a syntax error message.
      * @return Syntax error message
      */
-    string getMessage() const;
+    std::string getMessage() const;
 };
 
 //! Illegal option exeption
@@ -49,7 +47,7 @@ class IllegalValueException: public UsageException
 {
 public:
     IllegalValueException(char,
-                          string);
+                          std::string);
 };
 
 //! Invalid file exception
@@ -61,7 +59,7 @@ class InvalidFileException: public UsageException
 {
 public:
     InvalidFileException(char,
-                         string);
+                         std::string);
 };
 
 //! Missing value exception
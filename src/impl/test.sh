@@ -25,6 +25,34 @@ do
 	done
 done
 
+# Parallel test
+$PL_CMD -j 2 -i infix -o prefix -f "parser_infix_pos_in.txt" > $OUT_PATH"parser_parallel_test.txt" 2>&1
+if ! diff "parser_prefix_pos_in.txt" $OUT_PATH"parser_parallel_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Formula parser: Parallel test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Jobs range test
+$PL_CMD -j -1 -f "parser_infix_pos_in.txt" > $OUT_PATH"parser_jobs_test.txt" 2>&1
+$PL_CMD -j 1000000 -f "parser_infix_pos_in.txt" >> $OUT_PATH"parser_jobs_test.txt" 2>&1
+if ! diff "parser_jobs_out.txt" $OUT_PATH"parser_jobs_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Formula parser: Jobs range test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Premises range test
+$PL_CMD -D -1 -f "proof_search_in.txt" > $OUT_PATH"parser_premises_test.txt" 2>&1
+$PL_CMD -P -1 -f "proof_checker_pos_in.txt" >> $OUT_PATH"parser_premises_test.txt" 2>&1
+$PL_CMD -M -1 -f "proof_checker_pos_in.txt" >> $OUT_PATH"parser_premises_test.txt" 2>&1
+$PL_CMD -P 99999999999 -f "proof_checker_pos_in.txt" >> $OUT_PATH"parser_premises_test.txt" 2>&1
+if ! diff "parser_premises_out.txt" $OUT_PATH"parser_premises_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Formula parser: Premises range test failed!"
+	TEST_SUCCESS=0
+fi
+
 # Negative test
 for IN in prefix infix postfix
 do
@@ -36,6 +64,30 @@ do
 	fi
 done
 
+### Formula validator tests
+
+# Positive test
+for IN in prefix infix postfix
+do
+	$PL_CMD -V -i $IN -f "parser_"$IN"_pos_in.txt" > $OUT_PATH"formula_validator_"$IN"_pos_test.txt" 2>&1
+	if ! diff "formula_validator_pos_out.txt" $OUT_PATH"formula_validator_"$IN"_pos_test.txt" > "/dev/null" 2>&1;
+	then
+		echo "> Formula validator: Positive test failed! ($IN syntax)"
+		TEST_SUCCESS=0
+	fi
+done
+
+# Negative test
+for IN in prefix infix postfix
+do
+	$PL_CMD -V -i $IN -f "parser_"$IN"_neg_in.txt" > $OUT_PATH"formula_validator_"$IN"_neg_test.txt" 2>&1
+	if ! diff "parser_"$IN"_neg_out.txt" $OUT_PATH"formula_validator_"$IN"_neg_test.txt" > "/dev/null" 2>&1;
+	then
+		echo "> Formula validator: Negative test failed! ($IN syntax)"
+		TEST_SUCCESS=0
+	fi
+done
+
 ### Axiom checker tests
 
 # Positive test
@@ -54,6 +106,93 @@ then
 	TEST_SUCCESS=0
 fi
 
+# Parallel test
+$PL_CMD -A -j 2 -f "axiom_checker_neg_in.txt" > $OUT_PATH"axiom_checker_parallel_test.txt" 2>&1
+if ! diff "axiom_checker_neg_out.txt" $OUT_PATH"axiom_checker_parallel_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Axiom checker: Parallel test failed!"
+	TEST_SUCCESS=0
+fi
+
+### Truth table tests
+
+# Evaluation test
+$PL_CMD -T -f "truth_table_in.txt" > $OUT_PATH"truth_table_test.txt" 2>&1
+if ! diff "truth_table_out.txt" $OUT_PATH"truth_table_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Truth table: Evaluation test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Parallel test
+$PL_CMD -T -j 2 -f "truth_table_in.txt" > $OUT_PATH"truth_table_parallel_test.txt" 2>&1
+if ! diff "truth_table_out.txt" $OUT_PATH"truth_table_parallel_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Truth table: Parallel test failed!"
+	TEST_SUCCESS=0
+fi
+
+### Decision diagram tests
+
+# Tautology test
+$PL_CMD -B tautology -f "truth_table_in.txt" > $OUT_PATH"diagram_tautology_test.txt" 2>&1
+if ! diff "truth_table_out.txt" $OUT_PATH"diagram_tautology_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Decision diagram: Tautology test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Equivalence test
+$PL_CMD -B equivalence -f "diagram_equivalence_in.txt" > $OUT_PATH"diagram_equivalence_test.txt" 2>&1
+if ! diff "diagram_equivalence_out.txt" $OUT_PATH"diagram_equivalence_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Decision diagram: Equivalence test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Model counting test
+$PL_CMD -B count -f "truth_table_in.txt" > $OUT_PATH"diagram_count_test.txt" 2>&1
+if ! diff "diagram_count_out.txt" $OUT_PATH"diagram_count_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Decision diagram: Model counting test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Deep nesting test
+awk 'BEGIN { while (n++ < 300000) printf "-"; print "A" }' > $OUT_PATH"deep_prefix_in.txt"
+awk 'BEGIN { while (n++ < 300000) printf "("; printf "A"; while (--n > 0) printf ">%s)", n % 2 ? "A" : "B"; print "" }' > $OUT_PATH"deep_infix_in.txt"
+{
+	$PL_CMD -i prefix -B tautology -f $OUT_PATH"deep_prefix_in.txt"
+	$PL_CMD -i prefix -B count -f $OUT_PATH"deep_prefix_in.txt"
+	$PL_CMD -B tautology -f $OUT_PATH"deep_infix_in.txt"
+	$PL_CMD -B count -f $OUT_PATH"deep_infix_in.txt"
+} > $OUT_PATH"diagram_deep_test.txt" 2>&1
+if ! diff "diagram_deep_out.txt" $OUT_PATH"diagram_deep_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Decision diagram: Deep nesting test failed!"
+	TEST_SUCCESS=0
+fi
+
+### Satisfiability solver tests
+
+$PL_CMD -S -f "satisfiability_in.txt" > $OUT_PATH"satisfiability_test.txt" 2>&1
+if ! diff "satisfiability_out.txt" $OUT_PATH"satisfiability_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Satisfiability solver: Test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Deep nesting test
+{
+	$PL_CMD -i prefix -S -f $OUT_PATH"deep_prefix_in.txt"
+	$PL_CMD -S -f $OUT_PATH"deep_infix_in.txt"
+} > $OUT_PATH"satisfiability_deep_test.txt" 2>&1
+if ! diff "satisfiability_deep_out.txt" $OUT_PATH"satisfiability_deep_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Satisfiability solver: Deep nesting test failed!"
+	TEST_SUCCESS=0
+fi
+
 ### Proof checker tests
 
 # Positive test
@@ -72,6 +211,22 @@ then
 	TEST_SUCCESS=0
 fi
 
+# Annotated positive test
+$PL_CMD -P 1 -f "proof_annotated_pos_in.txt" > $OUT_PATH"proof_annotated_pos_test.txt" 2>&1
+if ! diff "proof_annotated_pos_out.txt" $OUT_PATH"proof_annotated_pos_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof checker: Annotated positive test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Annotated negative test
+$PL_CMD -P 0 -f "proof_annotated_neg_in.txt" > $OUT_PATH"proof_annotated_neg_test.txt" 2>&1
+if ! diff "proof_annotated_neg_out.txt" $OUT_PATH"proof_annotated_neg_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof checker: Annotated negative test failed!"
+	TEST_SUCCESS=0
+fi
+
 ### Proof minimizer tests
 
 # Positive test
@@ -90,6 +245,188 @@ then
 	TEST_SUCCESS=0
 fi
 
+### Proof certificate tests
+
+# Minimized proof test
+$PL_CMD -c -M 0 -f "proof_checker_pos_in.txt" > $OUT_PATH"proof_certificate_test.txt" 2>&1
+if ! diff "proof_certificate_out.txt" $OUT_PATH"proof_certificate_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof certificate: Minimized proof test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Re-checking test
+$PL_CMD -P 0 -f "proof_certificate_out.txt" > $OUT_PATH"proof_certificate_check_test.txt" 2>&1
+if ! diff "proof_certificate_check_out.txt" $OUT_PATH"proof_certificate_check_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof certificate: Re-checking test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Minimal proof test
+$PL_CMD -c -M 0 -f "proof_minimizer_pos_out.txt" > $OUT_PATH"proof_certificate_minimal_test.txt" 2>&1
+if ! diff "proof_minimizer_neg_out.txt" $OUT_PATH"proof_certificate_minimal_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof certificate: Minimal proof test failed!"
+	TEST_SUCCESS=0
+fi
+
+### Proof search tests
+
+# Search test
+$PL_CMD -D 4 -f "proof_search_in.txt" > $OUT_PATH"proof_search_test.txt" 2>&1
+if ! diff "proof_search_out.txt" $OUT_PATH"proof_search_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof search: Search test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Parallel search test
+$PL_CMD -D 4 -j 4 -f "proof_search_in.txt" > $OUT_PATH"proof_search_parallel_test.txt" 2>&1
+if ! diff "proof_search_out.txt" $OUT_PATH"proof_search_parallel_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof search: Parallel search test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Re-checking test, each blank line separated certificate on its own
+rm -f $OUT_PATH"proof_search_check_"*"_in.txt"
+awk -v prefix=$OUT_PATH"proof_search_check_" 'BEGIN { proof = 1 } /^$/ { proof++; next } !/^Proof not found/ { print > (prefix proof "_in.txt") }' "proof_search_out.txt"
+for IN in $OUT_PATH"proof_search_check_"*"_in.txt"
+do
+	$PL_CMD -P 4 -f $IN 2>&1
+	echo
+done > $OUT_PATH"proof_search_check_test.txt"
+if ! diff "proof_search_check_out.txt" $OUT_PATH"proof_search_check_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof search: Re-checking test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Theorems test
+$PL_CMD -D 0 -f "proof_search_theorems_in.txt" > $OUT_PATH"proof_search_theorems_test.txt" 2>&1
+if ! diff "proof_search_theorems_out.txt" $OUT_PATH"proof_search_theorems_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof search: Theorems test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Theorems re-checking test
+rm -f $OUT_PATH"proof_search_theorems_check_"*"_in.txt"
+awk -v prefix=$OUT_PATH"proof_search_theorems_check_" 'BEGIN { proof = 1 } /^$/ { proof++; next } { print > (prefix proof "_in.txt") }' "proof_search_theorems_out.txt"
+for IN in $OUT_PATH"proof_search_theorems_check_"*"_in.txt"
+do
+	$PL_CMD -P 0 -f $IN 2>&1
+	echo
+done > $OUT_PATH"proof_search_theorems_check_test.txt"
+if ! diff "proof_search_theorems_check_out.txt" $OUT_PATH"proof_search_theorems_check_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof search: Theorems re-checking test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Limits test
+$PL_CMD -D 0 --lemma-limit=100 -f "proof_search_theorems_in.txt" > $OUT_PATH"proof_search_limits_test.txt" 2>&1
+$PL_CMD -D 0 --depth-limit=0 >> $OUT_PATH"proof_search_limits_test.txt" 2>&1
+if ! diff "proof_search_limits_out.txt" $OUT_PATH"proof_search_limits_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Proof search: Limits test failed!"
+	TEST_SUCCESS=0
+fi
+
+### Statistics tests
+
+# Counters test
+$PL_CMD -M 0 --stats -f "proof_checker_pos_in.txt" 2>&1 > "/dev/null" | grep -v "^time\." > $OUT_PATH"statistics_test.txt"
+if ! diff "statistics_out.txt" $OUT_PATH"statistics_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Statistics: Counters test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Trace events test
+$PL_CMD -P 0 --trace=$OUT_PATH"trace_test.json" -f "proof_checker_pos_in.txt" > "/dev/null" 2>&1
+grep -o '"name":"[a-z_]*"' $OUT_PATH"trace_test.json" | sort | uniq -c > $OUT_PATH"trace_test.txt"
+if ! diff "trace_out.txt" $OUT_PATH"trace_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Statistics: Trace events test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Line trace events test
+$PL_CMD -A -j 1 --trace=$OUT_PATH"trace_line_test.json" -f "axiom_checker_pos_in.txt" > "/dev/null" 2>&1
+grep -o '"name":"[a-z_]*"\|"line":[0-9]*\|"lines":[0-9]*' $OUT_PATH"trace_line_test.json" | sort | uniq -c > $OUT_PATH"trace_line_test.txt"
+if ! diff "trace_line_out.txt" $OUT_PATH"trace_line_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Statistics: Line trace events test failed!"
+	TEST_SUCCESS=0
+fi
+
+### Socket server tests
+
+SOCKET=$OUT_PATH"socket_server.sock"
+CLIENT=$OUT_PATH"socketClient "$SOCKET
+rm -f $SOCKET
+$PL_CMD -j 4 -u $SOCKET > "/dev/null" 2>&1 &
+SERVER=$!
+
+# Requests test
+$CLIENT < "socket_server_in.txt" > $OUT_PATH"socket_server_test.txt" 2>&1
+if ! diff "socket_server_out.txt" $OUT_PATH"socket_server_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Socket server: Requests test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Concurrent clients test
+$CLIENT < "socket_server_in.txt" > $OUT_PATH"socket_server_first_test.txt" 2>&1 &
+$CLIENT < "socket_server_in.txt" > $OUT_PATH"socket_server_second_test.txt" 2>&1
+wait $!
+if ! diff "socket_server_out.txt" $OUT_PATH"socket_server_first_test.txt" > "/dev/null" 2>&1 \
+	|| ! diff "socket_server_out.txt" $OUT_PATH"socket_server_second_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Socket server: Concurrent clients test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Live socket test
+$PL_CMD -u $SOCKET > $OUT_PATH"socket_server_live_test.txt" 2>&1
+if ! diff "socket_server_live_out.txt" $OUT_PATH"socket_server_live_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Socket server: Live socket test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Stale socket test
+kill -KILL $SERVER
+wait $SERVER 2> "/dev/null"
+$PL_CMD -u $SOCKET > "/dev/null" 2>&1 &
+SERVER=$!
+$CLIENT < "socket_server_in.txt" > $OUT_PATH"socket_server_stale_test.txt" 2>&1
+if ! diff "socket_server_out.txt" $OUT_PATH"socket_server_stale_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Socket server: Stale socket test failed!"
+	TEST_SUCCESS=0
+fi
+
+# Termination test
+kill -TERM $SERVER
+wait $SERVER
+if [ -e $SOCKET ];
+then
+	echo "> Socket server: Termination test failed!"
+	TEST_SUCCESS=0
+fi
+
+### Embedding tests
+
+$OUT_PATH"embedding" > $OUT_PATH"embedding_test.txt" 2>&1
+if ! diff "embedding_out.txt" $OUT_PATH"embedding_test.txt" > "/dev/null" 2>&1;
+then
+	echo "> Embedding: Test failed!"
+	TEST_SUCCESS=0
+fi
+
 ### Summary
 
 if [ $TEST_SUCCESS -eq 1 ];
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+
+#include "context.hpp"
+#include "usageException.hpp"
+
+using namespace std;
+
+static const string PROOF =
+    "(A>((A>A)>A))\n"
+    "(A>((A>A)>A))\n"
+    "((A>((A>A)>A))>((A>(A>A))>(A>A)))\n"
+    "((A>(A>A))>(A>A))\n"
+    "(A>(A>A))\n"
+    "(A>A)";
+///< Proof with a repeated line and no trailing newline
+
+static const string PREMISE_PROOF =
+    "B\n"
+    "B ; PR 1\n"
+    "(B>(A>B)) ; AX 1\n"
+    "(A>B) ; MP 1 2\n";
+///< Annotated proof from one premise
+
+//! Report call
+
+/**
+ * Prints the outcome of an embedding call followed by its output.
+ * @param call Call description
+ * @param success Whether the call succeeded
+ * @param output Call output
+ */
+static void report(const string& call,
+                   bool success,
+                   const string& output)
+{
+    cout << call << ": " << (success ? "OK" : "FAIL") << endl;
+    if (!output.empty())
+    {
+        cout << output << (output.back() == '\n' ? "" : "\n");
+    }
+}
+
+//! Embedding test driver
+
+/**
+ * Calls the library interface on formulas and proofs held in memory and
+ * prints the outcomes, to be compared with the expected ones.
+ */
+int main()
+{
+    Context infix;
+    Context prefix("prefix", "infix", "words");
+    string output;
+    unsigned type;
+
+    // Formulas
+    report("parse (A>B)", infix.parse("(A>B)", output), "");
+    output.clear();
+    report("parse (A>", infix.parse("(A>", output), output);
+    output.clear();
+    report("parse A newline B", infix.parse("A\nB", output), output);
+    report("print (A>-B)", infix.print("(A>-B)", output), output);
+    report("print >A-B in prefix", prefix.print(">A-B", output), output);
+    output.clear();
+    type = infix.isAxiom("((-A>-B)>(B>A))", output);
+    report("isAxiom ((-A>-B)>(B>A))", type > 0, "Type " + to_string(type) + ".");
+    type = infix.isAxiom("(A>B)", output);
+    report("isAxiom (A>B)", type > 0, "Type " + to_string(type) + ".");
+    type = infix.isAxiom("(A>", output);
+    report("isAxiom (A>", type > 0, output);
+
+    // Proofs
+    report("verify unterminated", infix.verify(PROOF, 0, output), output);
+    report("verify terminated", infix.verify(PROOF + "\n", 0, output), output);
+    report("verify premise", infix.verify(PREMISE_PROOF, 1, output), output);
+    report("verify invalid", infix.verify("(A>B)", 0, output), output);
+    report("minimize unterminated", infix.minimize(PROOF, 0, output), output);
+    report("minimize minimal", infix.minimize("(A>(B>A))", 0, output), output);
+
+    // Configuration
+    try
+    {
+        Context unknown("unknown");
+        report("construct unknown", true, "");
+    } catch (UsageException& exception)
+    {
+        report("construct unknown", false, exception.getMessage());
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdlib.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const unsigned ATTEMPTS = 500;
+///< Count of connection attempts while the server is starting
+
+static const useconds_t DELAY = 10000;
+///< Delay between the connection attempts in microseconds
+
+//! Socket server test client
+
+/**
+ * Sends the standard input to the socket server listening on given path,
+ * shuts down the sending side and prints the responses until the server
+ * closes the connection.
+ */
+int main(int argc,
+         char** argv)
+{
+    sockaddr_un address;
+    string requests((istreambuf_iterator<char>(cin)), istreambuf_iterator<char>());
+    char buffer[4096];
+    ssize_t count;
+    int descriptor = -1;
+
+    if (argc != 2 || strlen(argv[1]) >= sizeof(address.sun_path))
+    {
+        cerr << "Usage: " << argv[0] << " socket" << endl;
+        return EXIT_FAILURE;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, argv[1]);
+
+    // Connection, waiting for the server to listen
+    for (unsigned attempt = 0; attempt < ATTEMPTS && descriptor < 0; attempt++)
+    {
+        descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(descriptor, (sockaddr*) &address, sizeof(address)) != 0)
+        {
+            close(descriptor);
+            descriptor = -1;
+            usleep(DELAY);
+        }
+    }
+    if (descriptor < 0)
+    {
+        cerr << "Cannot connect to " << argv[1] << "." << endl;
+        return EXIT_FAILURE;
+    }
+
+    // Requests sending and responses printing
+    for (size_t sent = 0; sent < requests.size(); sent += count)
+    {
+        count = send(descriptor, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+        if (count < 0 && errno != EINTR)
+        {
+            cerr << "Cannot send to " << argv[1] << "." << endl;
+            return EXIT_FAILURE;
+        }
+        count = count < 0 ? 0 : count;
+    }
+    shutdown(descriptor, SHUT_WR);
+    while ((count = read(descriptor, buffer, sizeof(buffer))) != 0)
+    {
+        if (count > 0)
+        {
+            cout.write(buffer, count);
+        } else if (errno != EINTR)
+        {
+            cerr << "Cannot receive from " << argv[1] << "." << endl;
+            return EXIT_FAILURE;
+        }
+    }
+    close(descriptor);
+    return EXIT_SUCCESS;
+}